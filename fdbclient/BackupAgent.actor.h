@@ -1041,10 +1041,27 @@ struct StringRefReader {
 };
 
 namespace fileBackup {
+// Returns the begin key, the kv pairs and the end key of a range file block, or nothing for a block index
 ACTOR Future<Standalone<VectorRef<KeyValueRef>>> decodeRangeFileBlock(Reference<IAsyncFile> file,
                                                                       int64_t offset,
                                                                       int len);
 
+// Decodes a range file block already read into buf, without reading or tracing, so it can also run off the network
+// thread. reader must be over buf, and is left where decoding stopped.
+Standalone<VectorRef<KeyValueRef>> decodeRangeFileBlockData(Standalone<StringRef> buf, StringRefReader& reader);
+
+// The block index of a compressed range file: the begin key of each data block followed by the end key of the file,
+// and the version of the file's data.
+struct RangeFileBlockIndex {
+	Version version;
+	Standalone<VectorRef<KeyRef>> boundaries;
+};
+
+// Reads the last block of a range file and returns the file's block index if that block is one.
+ACTOR Future<Optional<RangeFileBlockIndex>> readRangeFileBlockIndex(Reference<IAsyncFile> file,
+                                                                    int64_t fileSize,
+                                                                    int blockSize);
+
 // Return a block of contiguous padding bytes "\0xff" for backup files, growing if needed.
 Value makePadding(int size);
 } // namespace fileBackup
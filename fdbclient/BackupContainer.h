@@ -67,6 +67,13 @@ static const uint32_t PARTITIONED_MLOG_VERSION = 4110;
 // Snapshot file version written by FileBackupAgent
 static const uint32_t BACKUP_AGENT_SNAPSHOT_FILE_VERSION = 1001;
 
+// Snapshot file version written by FileBackupAgent with BACKUP_RANGE_FILE_COMPRESSION, in which each key is prefix
+// compressed against the previous key of its block
+static const uint32_t BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION = 1002;
+
+// Header of the block index that may follow the data blocks of a compressed snapshot file
+static const uint32_t BACKUP_AGENT_SNAPSHOT_INDEX_VERSION = 1003;
+
 struct LogFile {
 	Version beginVersion;
 	Version endVersion;
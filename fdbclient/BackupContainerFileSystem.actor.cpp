@@ -1317,11 +1317,24 @@ ACTOR static Future<KeyRange> getSnapshotFileKeyRange_impl(Reference<BackupConta
 	loop {
 		try {
 			state Reference<IAsyncFile> inFile = wait(bc->readFile(file.fileName));
+
+			// Files with a block index have their range in the last block
+			Optional<fileBackup::RangeFileBlockIndex> index =
+			    wait(fileBackup::readRangeFileBlockIndex(inFile, file.fileSize, file.blockSize));
+			if (index.present()) {
+				beginKey = index.get().boundaries.front();
+				endKey = index.get().boundaries.back();
+				break;
+			}
+
 			beginKeySet = false;
 			state int64_t j = 0;
 			for (; j < file.fileSize; j += file.blockSize) {
 				int64_t len = std::min<int64_t>(file.blockSize, file.fileSize - j);
 				Standalone<VectorRef<KeyValueRef>> blockData = wait(fileBackup::decodeRangeFileBlock(inFile, j, len));
+				if (blockData.empty()) {
+					continue;
+				}
 				if (!beginKeySet) {
 					beginKey = blockData.front().key;
 					beginKeySet = true;
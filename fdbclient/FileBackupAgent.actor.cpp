@@ -34,6 +34,7 @@
 #include "fdbrpc/IAsyncFile.h"
 #include "flow/genericactors.actor.h"
 #include "flow/Hash3.h"
+#include "flow/UnitTest.h"
 #include <numeric>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
@@ -438,6 +439,8 @@ Value makePadding(int size) {
 //
 // RangeFileWriter will insert the required padding, header, and extra
 // end/begin keys around the 1MB boundaries as needed.
+// When compressing, it prefix compresses the keys of each block and follows
+// the data blocks with a block index, see design/backup-dataFormat.md.
 //
 // Example:
 //   The range a-z is queries and returns c-j which covers 3 blocks.
@@ -458,8 +461,15 @@ Value makePadding(int size) {
 //   then the space after the final key to the next 1MB boundary would
 //   just be padding anyway.
 struct RangeFileWriter {
-	RangeFileWriter(Reference<IBackupFile> file = Reference<IBackupFile>(), int blockSize = 0)
-	  : file(file), blockSize(blockSize), blockEnd(0), fileVersion(BACKUP_AGENT_SNAPSHOT_FILE_VERSION) {}
+	RangeFileWriter(Reference<IBackupFile> file = Reference<IBackupFile>(), int blockSize = 0, bool compress = false)
+	  : file(file), blockSize(blockSize), keyBytesSaved(0), blockEnd(0),
+	    fileVersion(compress ? BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION : BACKUP_AGENT_SNAPSHOT_FILE_VERSION),
+	    startingBlock(false) {}
+
+	bool compressed() const { return fileVersion == BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION; }
+
+	// Bytes written for the length (and shared prefix length) of a key
+	int keyOverhead() const { return compressed() ? sizeof(uint16_t) + sizeof(uint32_t) : sizeof(uint32_t); }
 
 	// Handles the first block and internal blocks.  Ends current block if needed.
 	// The final flag is used in simulation to pad the file's final block to a whole block size
@@ -482,10 +492,14 @@ struct RangeFileWriter {
 		// write Header
 		wait(self->file->append((uint8_t*)&self->fileVersion, sizeof(self->fileVersion)));
 
+		// Keys are only compressed against keys of the same block, so that every block decodes on its own
+		self->prevKey = Key();
+		self->startingBlock = true;
+
 		// If this is NOT the first block then write duplicate stuff needed from last block
 		if (self->blockEnd > self->blockSize) {
-			wait(self->file->appendStringRefWithLen(self->lastKey));
-			wait(self->file->appendStringRefWithLen(self->lastKey));
+			wait(appendKey(self, self->lastKey));
+			wait(appendKey(self, self->lastKey));
 			wait(self->file->appendStringRefWithLen(self->lastValue));
 		}
 
@@ -496,6 +510,33 @@ struct RangeFileWriter {
 		return Void();
 	}
 
+	// Writes a key, which in the compressed format is the length of the prefix it shares with the previous key of
+	// the block followed by the rest of the key.
+	ACTOR static Future<Void> appendKey(RangeFileWriter* self, Key k) {
+		if (self->startingBlock) {
+			self->blockBoundaries.push_back_deep(self->blockBoundaries.arena(), k);
+			self->startingBlock = false;
+		}
+
+		if (!self->compressed()) {
+			wait(self->file->appendStringRefWithLen(k));
+			return Void();
+		}
+
+		// A shared prefix length never starts with 0xFF, which readers take as the start of the block padding
+		int maxPrefix = std::min({ k.size(), self->prevKey.size(), 0xFEFF });
+		state int prefix = 0;
+		while (prefix < maxPrefix && k[prefix] == self->prevKey[prefix])
+			++prefix;
+		state uint16_t prefixBuf = bigEndian16((uint16_t)prefix);
+		self->prevKey = k;
+		self->keyBytesSaved += prefix - (int)sizeof(prefixBuf);
+
+		wait(self->file->append(&prefixBuf, sizeof(prefixBuf)));
+		wait(self->file->appendStringRefWithLen(Standalone<StringRef>(k.substr(prefix), k.arena())));
+		return Void();
+	}
+
 	// Used in simulation only to create backup file sizes which are an integer multiple of the block size
 	Future<Void> padEnd() {
 		ASSERT(g_network->isSimulated());
@@ -514,9 +555,9 @@ struct RangeFileWriter {
 
 	// Start a new block if needed, then write the key and value
 	ACTOR static Future<Void> writeKV_impl(RangeFileWriter* self, Key k, Value v) {
-		int toWrite = sizeof(int32_t) + k.size() + sizeof(int32_t) + v.size();
+		int toWrite = self->keyOverhead() + k.size() + sizeof(int32_t) + v.size();
 		wait(self->newBlockIfNeeded(toWrite));
-		wait(self->file->appendStringRefWithLen(k));
+		wait(appendKey(self, k));
 		wait(self->file->appendStringRefWithLen(v));
 		self->lastKey = k;
 		self->lastValue = v;
@@ -527,24 +568,136 @@ struct RangeFileWriter {
 
 	// Write begin key or end key.
 	ACTOR static Future<Void> writeKey_impl(RangeFileWriter* self, Key k) {
-		int toWrite = sizeof(uint32_t) + k.size();
+		int toWrite = self->keyOverhead() + k.size();
 		wait(self->newBlockIfNeeded(toWrite));
-		wait(self->file->appendStringRefWithLen(k));
+		wait(appendKey(self, k));
+		self->endKey = k;
 		return Void();
 	}
 
 	Future<Void> writeKey(Key k) { return writeKey_impl(this, k); }
 
+	// After the end key of a compressed file, pads the last data block and writes the block index as the final block,
+	// so a reader can find the range of the file and of each block without decoding them. The index is left out when
+	// it would not fit in one block; readers then decode the blocks as for any other file.
+	ACTOR static Future<Void> writeIndex_impl(RangeFileWriter* self, Version version) {
+		if (!self->compressed() || self->blockBoundaries.empty()) {
+			return Void();
+		}
+
+		self->blockBoundaries.push_back_deep(self->blockBoundaries.arena(), self->endKey);
+		int64_t indexBytes = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+		for (const auto& k : self->blockBoundaries) {
+			indexBytes += sizeof(uint32_t) + k.size();
+		}
+		if (indexBytes > self->blockSize) {
+			TEST(true); // Range file block index does not fit in a block
+			return Void();
+		}
+
+		int bytesLeft = self->blockEnd - self->file->size();
+		if (bytesLeft > 0) {
+			state Value paddingFFs = makePadding(bytesLeft);
+			wait(self->file->append(paddingFFs.begin(), bytesLeft));
+		}
+
+		state uint32_t header = BACKUP_AGENT_SNAPSHOT_INDEX_VERSION;
+		state uint64_t versionBuf = bigEndian64((uint64_t)version);
+		state uint32_t countBuf = bigEndian32((uint32_t)self->blockBoundaries.size());
+		wait(self->file->append(&header, sizeof(header)));
+		wait(self->file->append(&versionBuf, sizeof(versionBuf)));
+		wait(self->file->append(&countBuf, sizeof(countBuf)));
+
+		state int i = 0;
+		for (; i < self->blockBoundaries.size(); ++i) {
+			wait(self->file->appendStringRefWithLen(
+			    Standalone<StringRef>(self->blockBoundaries[i], self->blockBoundaries.arena())));
+		}
+		return Void();
+	}
+
+	Future<Void> writeIndex(Version version) { return writeIndex_impl(this, version); }
+
 	Reference<IBackupFile> file;
 	int blockSize;
+	// Key bytes the compressed format did not have to write, net of the shared prefix lengths
+	int64_t keyBytesSaved;
 
 private:
 	int64_t blockEnd;
 	uint32_t fileVersion;
 	Key lastKey;
 	Key lastValue;
+	Key prevKey;
+	Key endKey;
+	bool startingBlock;
+	Standalone<VectorRef<KeyRef>> blockBoundaries;
 };
 
+// Reads a key written by RangeFileWriter::appendKey(). Compressed keys are rebuilt in arena from prevKey, which is
+// then set to the key read.
+static KeyRef consumeRangeFileKey(StringRefReader& reader, bool compressed, KeyRef& prevKey, Arena& arena) {
+	if (!compressed) {
+		uint32_t kLen = reader.consumeNetworkUInt32();
+		return KeyRef(reader.consume(kLen), kLen);
+	}
+
+	uint16_t prefix = reader.consume<uint16_t>();
+	prefix = bigEndian16(prefix);
+	uint32_t suffixLen = reader.consumeNetworkUInt32();
+	StringRef suffix(reader.consume(suffixLen), suffixLen);
+	if (prefix > prevKey.size())
+		throw restore_corrupted_data();
+
+	prevKey = prefix == 0 ? suffix : prevKey.substr(0, prefix).withSuffix(suffix, arena);
+	return prevKey;
+}
+
+Standalone<VectorRef<KeyValueRef>> decodeRangeFileBlockData(Standalone<StringRef> buf, StringRefReader& reader) {
+	Standalone<VectorRef<KeyValueRef>> results({}, buf.arena());
+
+	// Read header, which is either of the snapshot file versions or, for the last block, a block index
+	int32_t header = reader.consume<int32_t>();
+	if (header == BACKUP_AGENT_SNAPSHOT_INDEX_VERSION)
+		return results;
+	bool compressed = header == BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION;
+	if (!compressed && header != BACKUP_AGENT_SNAPSHOT_FILE_VERSION)
+		throw restore_unsupported_file_version();
+
+	// Read begin key, if this fails then block was invalid.
+	KeyRef prevKey;
+	KeyRef k = consumeRangeFileKey(reader, compressed, prevKey, results.arena());
+	results.push_back(results.arena(), KeyValueRef(k, ValueRef()));
+
+	// Read kv pairs and end key
+	while (1) {
+		// Read a key.
+		k = consumeRangeFileKey(reader, compressed, prevKey, results.arena());
+
+		// If eof reached or first value len byte is 0xFF then a valid block end was reached.
+		if (reader.eof() || *reader.rptr == 0xFF) {
+			results.push_back(results.arena(), KeyValueRef(k, ValueRef()));
+			break;
+		}
+
+		// Read a value, which must exist or the block is invalid
+		uint32_t vLen = reader.consumeNetworkUInt32();
+		const uint8_t* v = reader.consume(vLen);
+		results.push_back(results.arena(), KeyValueRef(k, ValueRef(v, vLen)));
+
+		// If eof reached or first byte of next key len is 0xFF then a valid block end was reached.
+		if (reader.eof() || *reader.rptr == 0xFF)
+			break;
+	}
+
+	// Make sure any remaining bytes in the block are 0xFF
+	for (auto b : reader.remainder())
+		if (b != 0xFF)
+			throw restore_corrupted_data_padding();
+
+	return results;
+}
+
 ACTOR Future<Standalone<VectorRef<KeyValueRef>>> decodeRangeFileBlock(Reference<IAsyncFile> file,
                                                                       int64_t offset,
                                                                       int len) {
@@ -555,48 +708,10 @@ ACTOR Future<Standalone<VectorRef<KeyValueRef>>> decodeRangeFileBlock(Reference<
 
 	simulateBlobFailure();
 
-	Standalone<VectorRef<KeyValueRef>> results({}, buf.arena());
 	state StringRefReader reader(buf, restore_corrupted_data());
 
 	try {
-		// Read header, currently only decoding BACKUP_AGENT_SNAPSHOT_FILE_VERSION
-		if (reader.consume<int32_t>() != BACKUP_AGENT_SNAPSHOT_FILE_VERSION)
-			throw restore_unsupported_file_version();
-
-		// Read begin key, if this fails then block was invalid.
-		uint32_t kLen = reader.consumeNetworkUInt32();
-		const uint8_t* k = reader.consume(kLen);
-		results.push_back(results.arena(), KeyValueRef(KeyRef(k, kLen), ValueRef()));
-
-		// Read kv pairs and end key
-		while (1) {
-			// Read a key.
-			kLen = reader.consumeNetworkUInt32();
-			k = reader.consume(kLen);
-
-			// If eof reached or first value len byte is 0xFF then a valid block end was reached.
-			if (reader.eof() || *reader.rptr == 0xFF) {
-				results.push_back(results.arena(), KeyValueRef(KeyRef(k, kLen), ValueRef()));
-				break;
-			}
-
-			// Read a value, which must exist or the block is invalid
-			uint32_t vLen = reader.consumeNetworkUInt32();
-			const uint8_t* v = reader.consume(vLen);
-			results.push_back(results.arena(), KeyValueRef(KeyRef(k, kLen), ValueRef(v, vLen)));
-
-			// If eof reached or first byte of next key len is 0xFF then a valid block end was reached.
-			if (reader.eof() || *reader.rptr == 0xFF)
-				break;
-		}
-
-		// Make sure any remaining bytes in the block are 0xFF
-		for (auto b : reader.remainder())
-			if (b != 0xFF)
-				throw restore_corrupted_data_padding();
-
-		return results;
-
+		return decodeRangeFileBlockData(buf, reader);
 	} catch (Error& e) {
 		TraceEvent(SevWarn, "FileRestoreDecodeRangeFileBlockFailed")
 		    .error(e)
@@ -609,6 +724,37 @@ ACTOR Future<Standalone<VectorRef<KeyValueRef>>> decodeRangeFileBlock(Reference<
 	}
 }
 
+ACTOR Future<Optional<RangeFileBlockIndex>> readRangeFileBlockIndex(Reference<IAsyncFile> file,
+                                                                    int64_t fileSize,
+                                                                    int blockSize) {
+	// An index always follows at least one data block
+	if (fileSize <= blockSize)
+		return Optional<RangeFileBlockIndex>();
+
+	state int64_t offset = (fileSize - 1) / blockSize * blockSize;
+	state int len = fileSize - offset;
+	state Standalone<StringRef> buf = makeString(len);
+	int rLen = wait(file->read(mutateString(buf), len, offset));
+	if (rLen != len)
+		throw restore_bad_read();
+
+	StringRefReader reader(buf, restore_corrupted_data());
+	if (reader.consume<int32_t>() != BACKUP_AGENT_SNAPSHOT_INDEX_VERSION)
+		return Optional<RangeFileBlockIndex>();
+
+	RangeFileBlockIndex index;
+	index.version = reader.consumeNetworkUInt64();
+	uint32_t count = reader.consumeNetworkUInt32();
+	if (count < 2)
+		throw restore_corrupted_data();
+	index.boundaries.arena().dependsOn(buf.arena());
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t kLen = reader.consumeNetworkUInt32();
+		index.boundaries.push_back(index.boundaries.arena(), KeyRef(reader.consume(kLen), kLen));
+	}
+	return index;
+}
+
 // Very simple format compared to KeyRange files.
 // Header, [Key, Value]... Key len
 struct LogFileWriter {
@@ -987,6 +1133,45 @@ struct BackupTaskFuncBase : TaskFuncBase {
 	virtual std::string toString(Reference<Task> task) const { return ""; }
 };
 
+// Snapshot bytes written by the range tasks of this agent process, traced as a rate every
+// BACKUP_SNAPSHOT_THROUGHPUT_INTERVAL seconds so that agents falling behind during a snapshot stand out.
+struct SnapshotThroughput {
+	double windowStart = 0;
+	int64_t bytes = 0;
+	int64_t uncompressedBytes = 0;
+	int64_t files = 0;
+	int64_t keys = 0;
+
+	// uncompressedSize is what the file would have taken in the uncompressed range file format
+	void addRangeFile(int64_t fileBytes, int64_t uncompressedSize, int64_t fileKeys) {
+		if (windowStart == 0) {
+			windowStart = now();
+		}
+		bytes += fileBytes;
+		uncompressedBytes += uncompressedSize;
+		keys += fileKeys;
+		++files;
+
+		double elapsed = now() - windowStart;
+		if (elapsed >= CLIENT_KNOBS->BACKUP_SNAPSHOT_THROUGHPUT_INTERVAL) {
+			TraceEvent("FileBackupSnapshotAgentThroughput")
+			    .detail("Elapsed", elapsed)
+			    .detail("Bytes", bytes)
+			    .detail("Files", files)
+			    .detail("Keys", keys)
+			    .detail("MBPerSecond", bytes / elapsed / 1e6)
+			    .detail("UncompressedMBPerSecond", uncompressedBytes / elapsed / 1e6)
+			    .detail("CompressionRatio", bytes > 0 ? (double)uncompressedBytes / bytes : 1.0);
+			windowStart = now();
+			bytes = 0;
+			uncompressedBytes = 0;
+			files = 0;
+			keys = 0;
+		}
+	}
+};
+static SnapshotThroughput snapshotThroughput;
+
 ACTOR static Future<Standalone<VectorRef<KeyRef>>> getBlockOfShards(Reference<ReadYourWritesTransaction> tr,
                                                                     Key beginKey,
                                                                     Key endKey,
@@ -1014,6 +1199,8 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 		static TaskParam<Key> beginKey() { return LiteralStringRef(__FUNCTION__); }
 		static TaskParam<Key> endKey() { return LiteralStringRef(__FUNCTION__); }
 		static TaskParam<bool> addBackupRangeTasks() { return LiteralStringRef(__FUNCTION__); }
+		// Set on tasks created from split points, which are not split again
+		static TaskParam<bool> sizedBySplitPoints() { return LiteralStringRef(__FUNCTION__); }
 	} Params;
 
 	std::string toString(Reference<Task> task) const override {
@@ -1109,7 +1296,8 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 	                                 Key end,
 	                                 TaskCompletionKey completionKey,
 	                                 Reference<TaskFuture> waitFor = Reference<TaskFuture>(),
-	                                 Version scheduledVersion = invalidVersion) {
+	                                 Version scheduledVersion = invalidVersion,
+	                                 bool sizedBySplitPoints = false) {
 		Key key = wait(addBackupTask(
 		    BackupRangeTaskFunc::name,
 		    BackupRangeTaskFunc::version,
@@ -1122,6 +1310,8 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 			    Params.beginKey().set(task, begin);
 			    Params.endKey().set(task, end);
 			    Params.addBackupRangeTasks().set(task, false);
+			    if (sizedBySplitPoints)
+				    Params.sizedBySplitPoints().set(task, true);
 			    if (scheduledVersion != invalidVersion)
 				    ReservedTaskParams::scheduledVersion().set(task, scheduledVersion);
 		    },
@@ -1129,11 +1319,30 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 		return key;
 	}
 
+	static bool splitBySize(Reference<Task> task) {
+		return CLIENT_KNOBS->BACKUP_RANGE_TASK_SPLIT_BYTES > 0 && !Params.sizedBySplitPoints().getOrDefault(task, false);
+	}
+
+	// The read ahead budget of one task. With BACKUP_AGENT_SNAPSHOT_MEMORY_BYTES set, the agent's budget is divided
+	// among its task slots, so more concurrent tasks per agent do not mean more memory per agent.
+	static int64_t readAheadBytes() {
+		if (CLIENT_KNOBS->BACKUP_AGENT_SNAPSHOT_MEMORY_BYTES <= 0) {
+			return CLIENT_KNOBS->BACKUP_LOCK_BYTES;
+		}
+		int tasksPerAgent =
+		    g_network->isSimulated() ? CLIENT_KNOBS->SIM_BACKUP_TASKS_PER_AGENT : CLIENT_KNOBS->BACKUP_TASKS_PER_AGENT;
+		// Always leave room for a second read in flight so reading overlaps with encoding and uploading
+		int64_t minBytes = 2 * (CLIENT_KNOBS->BACKUP_GET_RANGE_LIMIT_BYTES + CLIENT_KNOBS->VALUE_SIZE_LIMIT +
+		                        CLIENT_KNOBS->SYSTEM_KEY_SIZE_LIMIT);
+		int64_t shareBytes = CLIENT_KNOBS->BACKUP_AGENT_SNAPSHOT_MEMORY_BYTES / std::max(1, tasksPerAgent);
+		return std::max(minBytes, std::min<int64_t>(CLIENT_KNOBS->BACKUP_LOCK_BYTES, shareBytes));
+	}
+
 	ACTOR static Future<Void> _execute(Database cx,
 	                                   Reference<TaskBucket> taskBucket,
 	                                   Reference<FutureBucket> futureBucket,
 	                                   Reference<Task> task) {
-		state Reference<FlowLock> lock(new FlowLock(CLIENT_KNOBS->BACKUP_LOCK_BYTES));
+		state Reference<FlowLock> lock(new FlowLock(readAheadBytes()));
 
 		wait(checkTaskVersion(cx, task, BackupRangeTaskFunc::name, BackupRangeTaskFunc::version));
 
@@ -1160,6 +1369,23 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 			return Void();
 		}
 
+		// A single shard can still be much more than one task should read serially, so have finish() divide it at
+		// split points and spread the pieces over the task slots of all agents.
+		if (splitBySize(task)) {
+			Standalone<VectorRef<KeyRef>> splitPoints =
+			    wait(runRYWTransaction(cx, [=](Reference<ReadYourWritesTransaction> tr) {
+				    tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+				    tr->setOption(FDBTransactionOptions::LOCK_AWARE);
+				    return tr->getRangeSplitPoints(KeyRangeRef(beginKey, endKey),
+				                                   CLIENT_KNOBS->BACKUP_RANGE_TASK_SPLIT_BYTES);
+			    }));
+			// The begin and end keys are always included
+			if (splitPoints.size() > 2) {
+				Params.addBackupRangeTasks().set(task, true);
+				return Void();
+			}
+		}
+
 		// Read everything from beginKey to endKey, write it to an output file, run the output file processor, and
 		// then set on_done. If we are still writing after X seconds, end the output file and insert a new backup_range
 		// task for the remainder.
@@ -1207,6 +1433,7 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 					if (BUGGIFY) {
 						wait(rangeFile.padEnd());
 					}
+					wait(rangeFile.writeIndex(outVersion));
 
 					bool usedFile = wait(
 					    finishRangeFile(outFile, cx, task, taskBucket, KeyRangeRef(beginKey, nextKey), outVersion));
@@ -1218,8 +1445,11 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 					    .detail("ReadVersion", outVersion)
 					    .detail("BeginKey", beginKey.printable())
 					    .detail("EndKey", nextKey.printable())
-					    .detail("AddedFileToMap", usedFile);
+					    .detail("AddedFileToMap", usedFile)
+					    .detail("Compressed", rangeFile.compressed())
+					    .detail("KeyBytesSaved", rangeFile.keyBytesSaved);
 
+					snapshotThroughput.addRangeFile(outFile->size(), outFile->size() + rangeFile.keyBytesSaved, nrKeys);
 					nrKeys = 0;
 					beginKey = nextKey;
 				}
@@ -1258,7 +1488,7 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 				outFile = f;
 
 				// Initialize range file writer and write begin key
-				rangeFile = RangeFileWriter(outFile, blockSize);
+				rangeFile = RangeFileWriter(outFile, blockSize, CLIENT_KNOBS->BACKUP_RANGE_FILE_COMPRESSION);
 				wait(rangeFile.writeKey(beginKey));
 			}
 
@@ -1287,6 +1517,19 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 		state Standalone<VectorRef<KeyRef>> keys =
 		    wait(getBlockOfShards(tr, nextKey, endKey, CLIENT_KNOBS->BACKUP_SHARD_TASK_LIMIT));
 
+		// No shard boundary means the task was sent here because its shard is too large, so size the new tasks
+		// from the split points instead.
+		state bool sizedBySplitPoints = keys.empty() && splitBySize(task);
+		if (sizedBySplitPoints) {
+			Standalone<VectorRef<KeyRef>> splitPoints = wait(
+			    tr->getRangeSplitPoints(KeyRangeRef(nextKey, endKey), CLIENT_KNOBS->BACKUP_RANGE_TASK_SPLIT_BYTES));
+			int interior = std::min<int>(splitPoints.size() - 2, CLIENT_KNOBS->BACKUP_SHARD_TASK_LIMIT);
+			if (interior > 0) {
+				keys.append(keys.arena(), splitPoints.begin() + 1, interior);
+				keys.arena().dependsOn(splitPoints.arena());
+			}
+		}
+
 		std::vector<Future<Key>> addTaskVector;
 		for (int idx = 0; idx < keys.size(); ++idx) {
 			if (nextKey != keys[idx]) {
@@ -1296,14 +1539,18 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 				                                task->getPriority(),
 				                                nextKey,
 				                                keys[idx],
-				                                TaskCompletionKey::joinWith(onDone)));
+				                                TaskCompletionKey::joinWith(onDone),
+				                                Reference<TaskFuture>(),
+				                                invalidVersion,
+				                                sizedBySplitPoints));
 				TraceEvent("FileBackupRangeSplit")
 				    .suppressFor(60)
 				    .detail("BackupUID", BackupConfig(task).getUid())
 				    .detail("BeginKey", Params.beginKey().get(task).printable())
 				    .detail("EndKey", Params.endKey().get(task).printable())
 				    .detail("SliceBeginKey", nextKey.printable())
-				    .detail("SliceEndKey", keys[idx].printable());
+				    .detail("SliceEndKey", keys[idx].printable())
+				    .detail("SizedBySplitPoints", sizedBySplitPoints);
 			}
 			nextKey = keys[idx];
 		}
@@ -1320,7 +1567,8 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 			                     endKey,
 			                     TaskCompletionKey::joinWith(onDone),
 			                     Reference<TaskFuture>(),
-			                     task->getPriority())));
+			                     task->getPriority(),
+			                     sizedBySplitPoints)));
 		}
 
 		return Void();
@@ -2991,6 +3239,11 @@ struct RestoreRangeTaskFunc : RestoreFileTaskFuncBase {
 		state Reference<IAsyncFile> inFile = wait(bc.get()->readFile(rangeFile.fileName));
 		state Standalone<VectorRef<KeyValueRef>> blockData = wait(decodeRangeFileBlock(inFile, readOffset, readLen));
 
+		// The block index of a compressed file holds no data
+		if (blockData.empty()) {
+			return Void();
+		}
+
 		// First and last key are the range for this file
 		state KeyRange fileRange = KeyRangeRef(blockData.front().key, blockData.back().key);
 		state std::vector<KeyRange> originalFileRanges;
@@ -5873,3 +6126,82 @@ void simulateBlobFailure() {
 		}
 	}
 }
+
+TEST_CASE("/backup/rangeFile/compressed") {
+	state std::string url = g_network->isSimulated() ? format("file://simfdb/backups/%llx", timer_int())
+	                                                 : format("file:///private/tmp/fdb_backups/%llx", timer_int());
+	state Reference<IBackupContainer> c = IBackupContainer::openContainer(url);
+	wait(c->create());
+
+	state Version version = deterministicRandom()->randomInt64(1, 1e9);
+	state int blockSize = 1000;
+	state Reference<IBackupFile> file = wait(c->writeRangeFile(version, 0, version, blockSize));
+	state fileBackup::RangeFileWriter writer(file, blockSize, true);
+	state Standalone<VectorRef<KeyValueRef>> written;
+	state Key begin = LiteralStringRef("backup/compressed/");
+	state Key end = LiteralStringRef("backup/compressed0");
+
+	// Keys with long shared prefixes so that the file spans several blocks
+	state int i = 0;
+	for (; i < 100; ++i) {
+		Key k = begin.withSuffix(StringRef(format("%08d", i)));
+		std::string v(deterministicRandom()->randomInt(0, 50), 'v');
+		written.push_back_deep(written.arena(), KeyValueRef(k, StringRef(v)));
+	}
+	wait(writer.writeKey(begin));
+	for (i = 0; i < written.size(); ++i) {
+		wait(writer.writeKV(written[i].key, written[i].value));
+	}
+	wait(writer.writeKey(end));
+	wait(writer.writeIndex(version));
+	wait(file->finish());
+	ASSERT(writer.keyBytesSaved > 0);
+
+	state Reference<IAsyncFile> inFile = wait(c->readFile(file->getFileName()));
+	state int64_t fileSize = wait(inFile->size());
+	Optional<fileBackup::RangeFileBlockIndex> index =
+	    wait(fileBackup::readRangeFileBlockIndex(inFile, fileSize, blockSize));
+	ASSERT(index.present() && index.get().version == version);
+	state Standalone<VectorRef<KeyRef>> boundaries = index.get().boundaries;
+	ASSERT(boundaries.front() == begin && boundaries.back() == end);
+
+	// Every block but the index decodes on its own, starting at its index boundary, and all blocks together hold
+	// each written pair exactly once
+	state Standalone<VectorRef<KeyValueRef>> read;
+	state Standalone<VectorRef<KeyValueRef>> blockData;
+	state int blocks = 0;
+	state int64_t offset = 0;
+	for (; offset < fileSize; offset += blockSize) {
+		loop {
+			try {
+				Standalone<VectorRef<KeyValueRef>> data = wait(
+				    fileBackup::decodeRangeFileBlock(inFile, offset, std::min<int64_t>(blockSize, fileSize - offset)));
+				blockData = data;
+				break;
+			} catch (Error& e) {
+				// Decoding simulates blob store failures
+				if (e.code() != error_code_http_request_failed && e.code() != error_code_connection_failed &&
+				    e.code() != error_code_timed_out && e.code() != error_code_lookup_failed) {
+					throw;
+				}
+			}
+		}
+		if (blockData.empty()) {
+			ASSERT(offset + blockSize >= fileSize);
+			continue;
+		}
+		ASSERT(blockData.front().key == boundaries[blocks]);
+		for (int j = 1; j < blockData.size() - 1; ++j) {
+			read.push_back_deep(read.arena(), blockData[j]);
+		}
+		++blocks;
+	}
+	ASSERT(blocks > 1 && blocks == boundaries.size() - 1);
+	ASSERT(read.size() == written.size());
+	for (i = 0; i < written.size(); ++i) {
+		ASSERT(read[i].key == written[i].key && read[i].value == written[i].value);
+	}
+
+	wait(c->deleteContainer());
+	return Void();
+}
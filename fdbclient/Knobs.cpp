@@ -135,6 +135,10 @@ void ClientKnobs::initialize(bool randomize) {
 	init( BACKUP_SNAPSHOT_DISPATCH_INTERVAL_SEC,  10 * 60 );  // 10 minutes
 	init( BACKUP_DEFAULT_SNAPSHOT_INTERVAL_SEC,   3600 * 24 * 10); // 10 days
 	init( BACKUP_SHARD_TASK_LIMIT,                1000 ); if( randomize && BUGGIFY ) BACKUP_SHARD_TASK_LIMIT = 4;
+	init( BACKUP_RANGE_TASK_SPLIT_BYTES,             0 ); if( randomize && BUGGIFY ) BACKUP_RANGE_TASK_SPLIT_BYTES = deterministicRandom()->randomInt(1e4, 1e6);
+	init( BACKUP_AGENT_SNAPSHOT_MEMORY_BYTES,         0 ); if( randomize && BUGGIFY ) BACKUP_AGENT_SNAPSHOT_MEMORY_BYTES = deterministicRandom()->randomInt(1e6, 1e8);
+	init( BACKUP_SNAPSHOT_THROUGHPUT_INTERVAL,      5.0 );
+	init( BACKUP_RANGE_FILE_COMPRESSION,          false ); if( randomize && BUGGIFY ) BACKUP_RANGE_FILE_COMPRESSION = true;
 	init( BACKUP_AGGREGATE_POLL_RATE_UPDATE_INTERVAL, 60);
 	init( BACKUP_AGGREGATE_POLL_RATE,              2.0 ); // polls per second target for all agents on the cluster
 	init( BACKUP_LOG_WRITE_BATCH_MAX_SIZE,         1e6 ); //Must be much smaller than TRANSACTION_SIZE_LIMIT
@@ -131,6 +131,10 @@ public:
 	int BACKUP_SNAPSHOT_DISPATCH_INTERVAL_SEC;
 	int BACKUP_DEFAULT_SNAPSHOT_INTERVAL_SEC;
 	int BACKUP_SHARD_TASK_LIMIT;
+	int64_t BACKUP_RANGE_TASK_SPLIT_BYTES; // 0 disables splitting range tasks by size within a shard
+	int64_t BACKUP_AGENT_SNAPSHOT_MEMORY_BYTES; // 0 leaves each range task with BACKUP_LOCK_BYTES of read ahead
+	double BACKUP_SNAPSHOT_THROUGHPUT_INTERVAL;
+	bool BACKUP_RANGE_FILE_COMPRESSION; // Older versions cannot restore range files written with this set
 	double BACKUP_AGGREGATE_POLL_RATE;
 	double BACKUP_AGGREGATE_POLL_RATE_UPDATE_INTERVAL;
 	int BACKUP_LOG_WRITE_BATCH_MAX_SIZE;
@@ -280,6 +280,21 @@ const KeyRef JSONSchemas::statusSchema = LiteralStringRef(R"statusSchema(
                  "hz":0.0
                }
             },
+            "endpoint_latencies":[
+               {
+                  "message_type":"GetValueRequest",
+                  "queue_latency":{
+                     "count":0,
+                     "median":0.0,
+                     "p99":0.0
+                  },
+                  "service_latency":{
+                     "count":0,
+                     "median":0.0,
+                     "p99":0.0
+                  }
+               }
+            ],
             "run_loop_busy":0.2
          }
       },
@@ -387,6 +402,11 @@ const KeyRef JSONSchemas::statusSchema = LiteralStringRef(R"statusSchema(
          "worst_durability_lag_storage_server":{
             "versions":0,
             "seconds":0.0
+         },
+         "locally_throttled_storage_servers":{
+            "count":0,
+            "worst_pressure":0.0,
+            "worst_pressure_storage_server":"0ccb4e0fdbdb5583"
          }
       },
       "incompatible_connections":[
@@ -731,6 +751,8 @@ const KeyRef JSONSchemas::statusSchema = LiteralStringRef(R"statusSchema(
          "total_kv_size_bytes":0,
          "system_kv_size_bytes":0,
          "partitions_count":2,
+         "partitions_coalesced":0,
+         "partitions_coalesced_hz":0.0,
          "moving_data":{
             "total_written_bytes":0,
             "in_flight_bytes":0,
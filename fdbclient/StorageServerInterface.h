@@ -590,6 +590,22 @@ struct GetStorageMetricsRequest {
 	}
 };
 
+struct BusyTagInfo {
+	constexpr static FileIdentifier file_identifier = 4528694;
+	TransactionTag tag;
+	double rate;
+	double fractionalBusyness;
+
+	BusyTagInfo() : rate(0), fractionalBusyness(0) {}
+	BusyTagInfo(TransactionTag const& tag, double rate, double fractionalBusyness)
+	  : tag(tag), rate(rate), fractionalBusyness(fractionalBusyness) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, tag, rate, fractionalBusyness);
+	}
+};
+
 struct StorageQueuingMetricsReply {
 	constexpr static FileIdentifier file_identifier = 7633366;
 	double localTime;
@@ -604,6 +620,7 @@ struct StorageQueuingMetricsReply {
 	Optional<TransactionTag> busiestTag;
 	double busiestTagFractionalBusyness;
 	double busiestTagRate;
+	std::vector<BusyTagInfo> busiestTags; // The busiest few read tags, busiest first; busiestTag is the first
 
 	template <class Ar>
 	void serialize(Ar& ar) {
@@ -620,7 +637,8 @@ struct StorageQueuingMetricsReply {
 		           localRateLimit,
 		           busiestTag,
 		           busiestTagFractionalBusyness,
-		           busiestTagRate);
+		           busiestTagRate,
+		           busiestTags);
 	}
 };
 
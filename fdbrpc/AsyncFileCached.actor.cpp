@@ -19,6 +19,8 @@
  */
 
 #include "fdbrpc/AsyncFileCached.actor.h"
+#include "flow/UnitTest.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
 
 // Page caches used in non-simulated environments
 Optional<Reference<EvictablePageCache>> pc4k, pc64k;
@@ -34,16 +36,7 @@ EvictablePage::~EvictablePage() {
 		else
 			aligned_free(data);
 	}
-	if (EvictablePageCache::RANDOM == pageCache->cacheEvictionType) {
-		if (index > -1) {
-			pageCache->pages[index] = pageCache->pages.back();
-			pageCache->pages[index]->index = index;
-			pageCache->pages.pop_back();
-		}
-	} else {
-		// remove it from the LRU
-		pageCache->lruPages.erase(EvictablePageCache::List::s_iterator_to(*this));
-	}
+	pageCache->remove(this);
 }
 
 std::map<std::string, OpenFileInfo> AsyncFileCached::openFiles;
@@ -133,9 +126,48 @@ Future<Void> AsyncFileCached::read_write_impl(AsyncFileCached* self,
 	// AFCPage::readThrough or prevLength will be set prematurely
 	self->prevLength = self->length;
 
+	if constexpr (!writing) {
+		self->prefetchAfter(offset, length);
+	}
+
 	return waitForAll(actors);
 }
 
+void AsyncFileCached::prefetchAfter(int64_t offset, int length) {
+	if (FLOW_KNOBS->PAGE_CACHE_PREFETCH_PAGES <= 0 || length <= 0) {
+		return;
+	}
+
+	const int64_t pageSize = pageCache->pageSize;
+	int64_t firstPage = offset - offset % pageSize;
+	int64_t nextPage = (offset + length + pageSize - 1) / pageSize * pageSize;
+	if (firstPage == sequentialReadEnd) {
+		sequentialPages += (nextPage - firstPage) / pageSize;
+	} else {
+		sequentialPages = 0;
+		prefetchedThrough = 0;
+	}
+	sequentialReadEnd = nextPage;
+	if (sequentialPages < FLOW_KNOBS->PAGE_CACHE_PREFETCH_TRIGGER) {
+		return;
+	}
+
+	// Keep a window of PAGE_CACHE_PREFETCH_PAGES pages loading ahead of the reader, so a steady scan issues about one
+	// readahead per page it consumes
+	int64_t end = std::min(nextPage + FLOW_KNOBS->PAGE_CACHE_PREFETCH_PAGES * pageSize, this->length);
+	for (int64_t pageOffset = std::max(nextPage, prefetchedThrough); pageOffset < end; pageOffset += pageSize) {
+		if (pages.count(pageOffset)) {
+			continue;
+		}
+		AFCPage* page = new AFCPage(this, pageOffset);
+		pages[pageOffset] = page;
+		page->prefetch();
+		++countFileCachePagesPrefetched;
+		++countCachePagesPrefetched;
+	}
+	prefetchedThrough = std::max(prefetchedThrough, end);
+}
+
 Future<Void> AsyncFileCached::readZeroCopy(void** data, int* length, int64_t offset) {
 	++countFileCacheReads;
 	++countCacheReads;
@@ -154,7 +186,9 @@ Future<Void> AsyncFileCached::readZeroCopy(void** data, int* length, int64_t off
 
 	*data = p->second->data;
 
-	return p->second->readZeroCopy();
+	Future<Void> f = p->second->readZeroCopy();
+	prefetchAfter(offset, *length);
+	return f;
 }
 void AsyncFileCached::releaseZeroCopy(void* data, int length, int64_t offset) {
 	ASSERT(length == pageCache->pageSize && !(offset & (pageCache->pageSize - 1)) && offset + length <= this->length);
@@ -295,3 +329,56 @@ AsyncFileCached::~AsyncFileCached() {
 	}
 	openFiles.erase(filename);
 }
+
+namespace {
+
+struct TestEvictablePage : EvictablePage {
+	std::set<int>& resident;
+	int id;
+
+	TestEvictablePage(Reference<EvictablePageCache> pageCache, std::set<int>& resident, int id)
+	  : EvictablePage(pageCache), resident(resident), id(id) {
+		pageCache->allocate(this);
+		resident.insert(id);
+	}
+
+	bool evict() override {
+		resident.erase(id);
+		delete this;
+		return true;
+	}
+};
+
+// Loads two pages, touches them again, then scans scanPages pages once each through a four page cache
+std::set<int> hotPagesAfterScan(EvictablePageCache::CacheEvictionType type, int scanPages) {
+	auto cache = makeReference<EvictablePageCache>(4096, 4 * 4096, type);
+	std::set<int> resident;
+	std::vector<TestEvictablePage*> hot;
+	for (int i = 0; i < 2; ++i) {
+		hot.push_back(new TestEvictablePage(cache, resident, i));
+	}
+	for (auto page : hot) {
+		cache->updateHit(page);
+	}
+	for (int i = 0; i < scanPages; ++i) {
+		new TestEvictablePage(cache, resident, 100 + i);
+	}
+	std::set<int> result(resident.begin(), resident.lower_bound(100));
+	while (!cache->lruPages.empty()) {
+		cache->lruPages.front().evict();
+	}
+	while (!cache->probationPages.empty()) {
+		cache->probationPages.front().evict();
+	}
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("/fdbrpc/AsyncFileCached/2QScanResistance") {
+	// A scan longer than the cache flushes the hot pages out of a plain LRU
+	ASSERT(hotPagesAfterScan(EvictablePageCache::LRU, 10).empty());
+	// but only ever evicts from probation under 2Q
+	ASSERT(hotPagesAfterScan(EvictablePageCache::TWO_QUEUE, 10) == std::set<int>({ 0, 1 }));
+	return Void();
+}
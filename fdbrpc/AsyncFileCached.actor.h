@@ -44,36 +44,47 @@ struct EvictablePage {
 	int index;
 	class Reference<struct EvictablePageCache> pageCache;
 	bi::list_member_hook<> member_hook;
+	bool protectedPage; // With the 2Q policy, true once the page has been hit again after being loaded
+	bool prefetched; // Loaded by sequential readahead and not yet read, so its first hit does not count as a reuse
 
 	virtual bool evict() = 0; // true if page was evicted, false if it isn't immediately evictable (but will be evicted
 	                          // regardless if possible)
 
-	EvictablePage(Reference<EvictablePageCache> pageCache) : data(0), index(-1), pageCache(pageCache) {}
+	EvictablePage(Reference<EvictablePageCache> pageCache)
+	  : data(0), index(-1), pageCache(pageCache), protectedPage(false), prefetched(false) {}
 	virtual ~EvictablePage();
 };
 
 struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	using List =
 	    bi::list<EvictablePage, bi::member_hook<EvictablePage, bi::list_member_hook<>, &EvictablePage::member_hook>>;
-	enum CacheEvictionType { RANDOM = 0, LRU = 1 };
+	// TWO_QUEUE is the simplified 2Q policy: pages enter a probationary FIFO and only move to the protected LRU when
+	// they are hit again. Pages touched once by a scan are evicted from probation without displacing the hot set
+	// (for SQLite, mostly btree interior pages) that lives in the protected LRU.
+	enum CacheEvictionType { RANDOM = 0, LRU = 1, TWO_QUEUE = 2 };
 
 	static CacheEvictionType evictionPolicyStringToEnum(const std::string& policy) {
 		std::string cep = policy;
 		std::transform(cep.begin(), cep.end(), cep.begin(), ::tolower);
-		if (cep != "random" && cep != "lru")
+		if (cep != "random" && cep != "lru" && cep != "2q")
 			throw invalid_cache_eviction_policy();
 
 		if (cep == "random")
 			return RANDOM;
+		if (cep == "2q")
+			return TWO_QUEUE;
 		return LRU;
 	}
 
 	EvictablePageCache() : pageSize(0), maxPages(0), cacheEvictionType(RANDOM) {}
 
 	explicit EvictablePageCache(int pageSize, int64_t maxSize)
-	  : pageSize(pageSize), maxPages(maxSize / pageSize),
-	    cacheEvictionType(evictionPolicyStringToEnum(FLOW_KNOBS->CACHE_EVICTION_POLICY)) {
+	  : EvictablePageCache(pageSize, maxSize, evictionPolicyStringToEnum(FLOW_KNOBS->CACHE_EVICTION_POLICY)) {}
+
+	EvictablePageCache(int pageSize, int64_t maxSize, CacheEvictionType cacheEvictionType)
+	  : pageSize(pageSize), maxPages(maxSize / pageSize), cacheEvictionType(cacheEvictionType) {
 		cacheEvictions.init(LiteralStringRef("EvictablePageCache.CacheEvictions"));
+		cacheProbationEvictions.init(LiteralStringRef("EvictablePageCache.CacheProbationEvictions"));
 	}
 
 	void allocate(EvictablePage* page) {
@@ -83,19 +94,60 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 		if (RANDOM == cacheEvictionType) {
 			page->index = pages.size();
 			pages.push_back(page);
+		} else if (TWO_QUEUE == cacheEvictionType) {
+			probationPages.push_back(*page);
 		} else {
 			lruPages.push_back(*page); // new page is considered the most recently used (placed at LRU tail)
 		}
 	}
 
 	void updateHit(EvictablePage* page) {
-		if (RANDOM != cacheEvictionType) {
+		if (TWO_QUEUE == cacheEvictionType && !page->protectedPage) {
+			// a second touch promotes the page out of probation, but the first read of a prefetched page is its
+			// first real touch
+			probationPages.erase(List::s_iterator_to(*page));
+			if (page->prefetched) {
+				page->prefetched = false;
+				probationPages.push_back(*page);
+			} else {
+				page->protectedPage = true;
+				lruPages.push_back(*page);
+			}
+		} else if (RANDOM != cacheEvictionType) {
 			// on a hit, update page's location in the LRU so that it's most recent (tail)
 			lruPages.erase(List::s_iterator_to(*page));
 			lruPages.push_back(*page);
 		}
 	}
 
+	void remove(EvictablePage* page) {
+		if (RANDOM == cacheEvictionType) {
+			if (page->index > -1) {
+				pages[page->index] = pages.back();
+				pages[page->index]->index = page->index;
+				pages.pop_back();
+			}
+		} else if (TWO_QUEUE == cacheEvictionType && !page->protectedPage) {
+			probationPages.erase(List::s_iterator_to(*page));
+		} else {
+			lruPages.erase(List::s_iterator_to(*page));
+		}
+	}
+
+	// Tries the pages of list from least recently used, returning true if one was evicted
+	bool evictFrom(List& list) {
+		int i = 0;
+		for (List::iterator it = list.begin(); it != list.end() && i < FLOW_KNOBS->MAX_EVICT_ATTEMPTS; ++i) {
+			// evict() destroys the page, unlinking it from the list
+			EvictablePage& page = *it++;
+			if (page.evict()) {
+				++cacheEvictions;
+				return true;
+			}
+		}
+		return false;
+	}
+
 	void try_evict() {
 		if (RANDOM == cacheEvictionType) {
 			if (pages.size() >= (uint64_t)maxPages && !pages.empty()) {
@@ -108,8 +160,23 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 					}
 				}
 			}
+		} else if (TWO_QUEUE == cacheEvictionType) {
+			if (probationPages.size() + lruPages.size() >= (uint64_t)maxPages) {
+				// Probation gives up pages first unless it has shrunk below its share of the cache, so a scan can
+				// never push more than that share of the protected pages out.
+				bool probationFirst = lruPages.empty() ||
+				                      probationPages.size() >= maxPages * FLOW_KNOBS->PAGE_CACHE_2Q_PROBATION_FRACTION;
+				if (probationFirst) {
+					if (evictFrom(probationPages)) {
+						++cacheProbationEvictions;
+					} else {
+						evictFrom(lruPages);
+					}
+				} else if (!evictFrom(lruPages) && evictFrom(probationPages)) {
+					++cacheProbationEvictions;
+				}
+			}
 		} else {
-			// For now, LRU is the only other CACHE_EVICTION option
 			if (lruPages.size() >= (uint64_t)maxPages) {
 				int i = 0;
 				// try the least recently used pages first (starting at head of the LRU list)
@@ -126,9 +193,11 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 
 	std::vector<EvictablePage*> pages;
 	List lruPages;
+	List probationPages;
 	int pageSize;
 	int64_t maxPages;
 	Int64MetricHandle cacheEvictions;
+	Int64MetricHandle cacheProbationEvictions;
 	const CacheEvictionType cacheEvictionType;
 };
 
@@ -274,6 +343,9 @@ private:
 	Future<Void> currentTruncate;
 	int64_t currentTruncateSize;
 	Reference<IRateControl> rateControl;
+	int64_t sequentialReadEnd;
+	int64_t sequentialPages;
+	int64_t prefetchedThrough;
 
 	// Map of pointers which hold page buffers for pages which have been overwritten
 	// but at the time of write there were still readZeroCopy holders.
@@ -288,6 +360,7 @@ private:
 	Int64MetricHandle countFileCachePageReadsMissed;
 	Int64MetricHandle countFileCachePageReadsMerged;
 	Int64MetricHandle countFileCacheReadBytes;
+	Int64MetricHandle countFileCachePagesPrefetched;
 
 	Int64MetricHandle countCacheFinds;
 	Int64MetricHandle countCacheReads;
@@ -298,13 +371,15 @@ private:
 	Int64MetricHandle countCachePageReadsMissed;
 	Int64MetricHandle countCachePageReadsMerged;
 	Int64MetricHandle countCacheReadBytes;
+	Int64MetricHandle countCachePagesPrefetched;
 
 	AsyncFileCached(Reference<IAsyncFile> uncached,
 	                const std::string& filename,
 	                int64_t length,
 	                Reference<EvictablePageCache> pageCache)
 	  : uncached(uncached), filename(filename), length(length), prevLength(length), pageCache(pageCache),
-	    currentTruncate(Void()), currentTruncateSize(0), rateControl(nullptr) {
+	    currentTruncate(Void()), currentTruncateSize(0), rateControl(nullptr), sequentialReadEnd(-1),
+	    sequentialPages(0), prefetchedThrough(0) {
 		if (!g_network->isSimulated()) {
 			countFileCacheWrites.init(LiteralStringRef("AsyncFile.CountFileCacheWrites"), filename);
 			countFileCacheReads.init(LiteralStringRef("AsyncFile.CountFileCacheReads"), filename);
@@ -315,6 +390,7 @@ private:
 			countFileCachePageReadsMerged.init(LiteralStringRef("AsyncFile.CountFileCachePageReadsMerged"), filename);
 			countFileCacheFinds.init(LiteralStringRef("AsyncFile.CountFileCacheFinds"), filename);
 			countFileCacheReadBytes.init(LiteralStringRef("AsyncFile.CountFileCacheReadBytes"), filename);
+			countFileCachePagesPrefetched.init(LiteralStringRef("AsyncFile.CountFileCachePagesPrefetched"), filename);
 
 			countCacheWrites.init(LiteralStringRef("AsyncFile.CountCacheWrites"));
 			countCacheReads.init(LiteralStringRef("AsyncFile.CountCacheReads"));
@@ -325,6 +401,7 @@ private:
 			countCachePageReadsMerged.init(LiteralStringRef("AsyncFile.CountCachePageReadsMerged"));
 			countCacheFinds.init(LiteralStringRef("AsyncFile.CountCacheFinds"));
 			countCacheReadBytes.init(LiteralStringRef("AsyncFile.CountCacheReadBytes"));
+			countCachePagesPrefetched.init(LiteralStringRef("AsyncFile.CountCachePagesPrefetched"));
 		}
 	}
 
@@ -360,6 +437,9 @@ private:
 
 	Future<Void> quiesce();
 
+	// Tracks runs of sequential page reads and, once a run is long enough, starts reading the pages that follow it
+	void prefetchAfter(int64_t offset, int length);
+
 	ACTOR static Future<Void> waitAndSync(AsyncFileCached* self, Future<Void> flush) {
 		wait(flush);
 		wait(self->uncached->sync());
@@ -490,6 +570,14 @@ struct AFCPage : public EvictablePage, public FastAllocated<AFCPage> {
 		return notReading;
 	}
 
+	// Starts loading the page ahead of a read
+	void prefetch() {
+		if (!valid && notReading.isReady()) {
+			prefetched = true;
+			notReading = readThrough(this);
+		}
+	}
+
 	ACTOR static Future<Void> waitAndRead(AFCPage* self, void* data, int length, int offset) {
 		wait(self->notReading);
 		memcpy(data, static_cast<uint8_t const*>(self->data) + offset, length);
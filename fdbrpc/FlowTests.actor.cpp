@@ -24,6 +24,7 @@
 #include "flow/UnitTest.h"
 #include "flow/DeterministicRandom.h"
 #include "flow/IThreadPool.h"
+#include "flow/ThreadSafeQueue.h"
 #include "fdbrpc/fdbrpc.h"
 #include "fdbrpc/IAsyncFile.h"
 #include "flow/TLSConfig.actor.h"
@@ -1484,3 +1485,77 @@ TEST_CASE("/flow/flow/PromiseStream/move2") {
 	ASSERT(movedTracker.copied == 0);
 	return Void();
 }
+
+struct LaneReceiver final : IThreadPoolReceiver {
+	void init() override {}
+
+	struct LaneAction final : TypedAction<LaneReceiver, LaneAction> {
+		ThreadActionLane lane;
+		ThreadReturnPromise<ThreadActionLane> done;
+		explicit LaneAction(ThreadActionLane lane) : lane(lane) {}
+		double getTimeEstimate() const override { return 0; }
+		ThreadActionLane getLane() const override { return lane; }
+	};
+	void action(LaneAction& a) { a.done.send(a.lane); }
+};
+
+TEST_CASE("/flow/IThreadPool/workStealing") {
+	// Real threads would make simulation nondeterministic
+	if (g_network->isSimulated()) {
+		return Void();
+	}
+	state Reference<IThreadPool> pool = createWorkStealingThreadPool("WorkStealingTest");
+	state std::vector<Future<ThreadActionLane>> results;
+	state int i;
+	for (i = 0; i < 4; ++i) {
+		pool->addThread(new LaneReceiver, "fdb-unit-test");
+	}
+	for (i = 0; i < 1000; ++i) {
+		auto lane = deterministicRandom()->coinflip() ? ThreadActionLane::High : ThreadActionLane::Low;
+		auto a = new LaneReceiver::LaneAction(lane);
+		results.push_back(a->done.getFuture());
+		pool->post(a);
+	}
+	wait(waitForAll(results));
+	wait(pool->stop());
+
+	// Actions posted after stop() are cancelled rather than silently dropped
+	auto a = new LaneReceiver::LaneAction(ThreadActionLane::High);
+	state Future<ThreadActionLane> cancelled = a->done.getFuture();
+	pool->post(a);
+	try {
+		wait(success(cancelled));
+		ASSERT(false);
+	} catch (Error& e) {
+		ASSERT(e.code() == error_code_broken_promise);
+	}
+	return Void();
+}
+
+TEST_CASE("/flow/BoundedThreadSafeQueue/wake") {
+	BoundedThreadSafeQueue<int, 4> q;
+	bool wake = false;
+
+	ASSERT(q.canSleep());
+	ASSERT(q.tryPush(0, wake) && wake);
+	// Only the first push after canSleep() needs to wake the consumer
+	ASSERT(q.tryPush(1, wake) && !wake);
+	ASSERT(!q.canSleep());
+	ASSERT(q.tryPush(2, wake) && !wake);
+	ASSERT(q.tryPush(3, wake) && !wake);
+	ASSERT(!q.tryPush(4, wake));
+
+	for (int i = 0; i < 4; ++i) {
+		Optional<int> v = q.pop();
+		ASSERT(v.present() && v.get() == i);
+	}
+	ASSERT(!q.pop().present());
+
+	// Wrapping around the ring
+	for (int i = 0; i < 10; ++i) {
+		ASSERT(q.canSleep());
+		ASSERT(q.tryPush(i, wake) && wake);
+		ASSERT(q.pop().get() == i);
+	}
+	return Void();
+}
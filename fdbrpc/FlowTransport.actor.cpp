@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <unordered_map>
+#include <boost/core/demangle.hpp>
 #if VALGRIND
 #include <memcheck.h>
 #endif
@@ -37,6 +38,7 @@
 #include "flow/ActorCollection.h"
 #include "flow/Error.h"
 #include "flow/flow.h"
+#include "flow/Histogram.h"
 #include "flow/Net2Packet.h"
 #include "flow/TDMetric.actor.h"
 #include "flow/ObjectSerializer.h"
@@ -45,6 +47,8 @@
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 static NetworkAddressList g_currentDeliveryPeerAddress = NetworkAddressList();
+// The type of the message being delivered, or void outside of a delivery
+static std::type_index g_currentDeliveryMessageType = typeid(void);
 
 constexpr UID WLTOKEN_ENDPOINT_NOT_FOUND(-1, 0);
 constexpr UID WLTOKEN_PING_PACKET(-1, 1);
@@ -276,6 +280,30 @@ public:
 
 	Future<Void> multiVersionCleanup;
 	Future<Void> pingLogger;
+	Future<Void> endpointLatencyLogger;
+
+	// With ENDPOINT_LATENCY_HISTOGRAMS, each message type has histograms that go to the trace log with the periodic
+	// histogram report, and samples since the last EndpointLatencyMetrics event, which status reports per process
+	struct EndpointLatencies {
+		std::string messageType;
+		Reference<Histogram> queueHistogram, serviceHistogram;
+		ContinuousSample<double> queue, service;
+
+		explicit EndpointLatencies(std::string const& messageType)
+		  : messageType(messageType), queue(FLOW_KNOBS->ENDPOINT_LATENCY_SAMPLE_AMOUNT),
+		    service(FLOW_KNOBS->ENDPOINT_LATENCY_SAMPLE_AMOUNT) {}
+
+		uint64_t count() const { return queue.getPopulationSize() + service.getPopulationSize(); }
+	};
+	std::unordered_map<std::type_index, EndpointLatencies> endpointLatencies;
+
+	EndpointLatencies& getEndpointLatencies(std::type_index type) {
+		auto it = endpointLatencies.find(type);
+		if (it == endpointLatencies.end()) {
+			it = endpointLatencies.emplace(type, EndpointLatencies(boost::core::demangle(type.name()))).first;
+		}
+		return it->second;
+	}
 };
 
 ACTOR Future<Void> pingLatencyLogger(TransportData* self) {
@@ -333,12 +361,56 @@ ACTOR Future<Void> pingLatencyLogger(TransportData* self) {
 	}
 }
 
+// Logs the latencies of the message types with the most samples since the last event, for status
+ACTOR Future<Void> endpointLatencyLogger(TransportData* self) {
+	loop {
+		wait(delay(FLOW_KNOBS->ENDPOINT_LATENCY_LOGGING_INTERVAL));
+		if (!FLOW_KNOBS->ENDPOINT_LATENCY_HISTOGRAMS) {
+			continue;
+		}
+
+		std::vector<TransportData::EndpointLatencies*> busiest;
+		for (auto& it : self->endpointLatencies) {
+			if (it.second.count() > 0) {
+				busiest.push_back(&it.second);
+			}
+		}
+		int logged = std::min<int>(busiest.size(), FLOW_KNOBS->ENDPOINT_LATENCY_LOGGED_TYPES);
+		std::partial_sort(busiest.begin(),
+		                  busiest.begin() + logged,
+		                  busiest.end(),
+		                  [](TransportData::EndpointLatencies* a, TransportData::EndpointLatencies* b) {
+			                  return a->count() > b->count();
+		                  });
+
+		TraceEvent e("EndpointLatencyMetrics");
+		e.detail("Elapsed", FLOW_KNOBS->ENDPOINT_LATENCY_LOGGING_INTERVAL).detail("MessageTypes", logged);
+		for (int i = 0; i < logged; ++i) {
+			auto l = busiest[i];
+			std::string prefix = format("MessageType%d", i);
+			e.detail(prefix.c_str(), l->messageType)
+			    .detail((prefix + "QueueCount").c_str(), l->queue.getPopulationSize())
+			    .detail((prefix + "QueueMedian").c_str(), l->queue.median())
+			    .detail((prefix + "QueueP99").c_str(), l->queue.percentile(0.99))
+			    .detail((prefix + "ServiceCount").c_str(), l->service.getPopulationSize())
+			    .detail((prefix + "ServiceMedian").c_str(), l->service.median())
+			    .detail((prefix + "ServiceP99").c_str(), l->service.percentile(0.99));
+		}
+		for (auto& it : self->endpointLatencies) {
+			it.second.queue.clear();
+			it.second.service.clear();
+		}
+		e.trackLatest("EndpointLatencyMetrics");
+	}
+}
+
 TransportData::TransportData(uint64_t transportId)
   : endpoints(/*wellKnownTokenCount*/ 11), endpointNotFoundReceiver(endpoints), pingReceiver(endpoints),
     warnAlwaysForLargePacket(true), lastIncompatibleMessage(0), transportId(transportId),
     numIncompatibleConnections(0) {
 	degraded = makeReference<AsyncVar<bool>>(false);
 	pingLogger = pingLatencyLogger(this);
+	endpointLatencyLogger = ::endpointLatencyLogger(this);
 }
 
 #define CONNECT_PACKET_V0 0x0FDB00A444020001LL
@@ -905,6 +977,7 @@ ACTOR static void deliver(TransportData* self,
                           TaskPriority priority,
                           ArenaReader reader,
                           bool inReadSocket) {
+	state double arrivalTime = now();
 	// We want to run the task at the right priority. If the priority
 	// is higher than the current priority (which is ReadSocket) we
 	// can just upgrade. Otherwise we'll context switch so that we
@@ -920,15 +993,21 @@ ACTOR static void deliver(TransportData* self,
 		if (!checkCompatible(receiver->peerCompatibilityPolicy(), reader.protocolVersion())) {
 			return;
 		}
+		if (FLOW_KNOBS->ENDPOINT_LATENCY_HISTOGRAMS) {
+			FlowTransport::transport().sampleQueueLatency(receiver->messageType(), now() - arrivalTime);
+		}
 		try {
 			g_currentDeliveryPeerAddress = destination.addresses;
+			g_currentDeliveryMessageType = receiver->messageType();
 			StringRef data = reader.arenaReadAll();
 			ASSERT(data.size() > 8);
 			ArenaObjectReader objReader(reader.arena(), reader.arenaReadAll(), AssumeVersion(reader.protocolVersion()));
 			receiver->receive(objReader);
 			g_currentDeliveryPeerAddress = { NetworkAddress() };
+			g_currentDeliveryMessageType = typeid(void);
 		} catch (Error& e) {
 			g_currentDeliveryPeerAddress = { NetworkAddress() };
+			g_currentDeliveryMessageType = typeid(void);
 			TraceEvent(SevError, "ReceiverError")
 			    .error(e)
 			    .detail("Token", destination.token.toString())
@@ -1691,3 +1770,29 @@ void FlowTransport::createInstance(bool isClient, uint64_t transportId) {
 HealthMonitor* FlowTransport::healthMonitor() {
 	return &self->healthMonitor;
 }
+
+static void sampleLatency(Reference<Histogram>& histogram,
+                          ContinuousSample<double>& sample,
+                          StringRef group,
+                          std::string const& messageType,
+                          double seconds) {
+	if (!histogram) {
+		histogram = Histogram::getHistogram(group, StringRef(messageType), Histogram::Unit::microseconds);
+	}
+	histogram->sampleSeconds(seconds);
+	sample.addSample(seconds);
+}
+
+void FlowTransport::sampleQueueLatency(std::type_index messageType, double seconds) {
+	auto& l = self->getEndpointLatencies(messageType);
+	sampleLatency(l.queueHistogram, l.queue, LiteralStringRef("EndpointQueueLatency"), l.messageType, seconds);
+}
+
+std::type_index FlowTransport::loadedMessageType() {
+	return g_currentDeliveryMessageType;
+}
+
+void FlowTransport::sampleServiceLatency(std::type_index requestType, double seconds) {
+	auto& l = self->getEndpointLatencies(requestType);
+	sampleLatency(l.serviceHistogram, l.service, LiteralStringRef("EndpointServiceLatency"), l.messageType, seconds);
+}
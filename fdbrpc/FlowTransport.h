@@ -23,6 +23,7 @@
 #pragma once
 
 #include <algorithm>
+#include <typeindex>
 #include "fdbrpc/HealthMonitor.h"
 #include "flow/genericactors.actor.h"
 #include "flow/network.h"
@@ -124,6 +125,8 @@ public:
 	virtual PeerCompatibilityPolicy peerCompatibilityPolicy() const {
 		return { RequirePeer::Exactly, g_network->protocolVersion() };
 	}
+	// Names the latency histograms of this endpoint
+	virtual std::type_index messageType() const { return typeid(*this); }
 };
 
 struct TransportData;
@@ -249,6 +252,15 @@ public:
 
 	HealthMonitor* healthMonitor();
 
+	void sampleQueueLatency(std::type_index messageType, double seconds);
+	// Records how long a message of the given type waited between arriving and being delivered to its endpoint
+
+	std::type_index loadedMessageType();
+	// The type of the request being delivered while it is deserialized, as loadedEndpoint() is for its sender, or void
+
+	void sampleServiceLatency(std::type_index requestType, double seconds);
+	// Records how long it took from delivering a request of the given type to sending its reply
+
 private:
 	class TransportData* self;
 };
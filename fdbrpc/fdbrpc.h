@@ -96,6 +96,7 @@ struct NetSAV final : SAV<T>, FlowReceiver, FastAllocated<NetSAV<T>> {
 	  : SAV<T>(futures, promises), FlowReceiver(remoteEndpoint, false) {}
 
 	void destroy() override { delete this; }
+	std::type_index messageType() const override { return typeid(T); }
 	void receive(ArenaObjectReader& reader) override {
 		if (!SAV<T>::canBeSet())
 			return;
@@ -189,7 +190,7 @@ void load(Ar& ar, ReplyPromise<T>& value) {
 	ar >> token;
 	Endpoint endpoint = FlowTransport::transport().loadedEndpoint(token);
 	value = ReplyPromise<T>(endpoint);
-	networkSender(value.getFuture(), endpoint);
+	networkSender(value.getFuture(), endpoint, FlowTransport::transport().loadedMessageType());
 }
 
 template <class T>
@@ -201,7 +202,7 @@ struct serializable_traits<ReplyPromise<T>> : std::true_type {
 			serializer(ar, token);
 			auto endpoint = FlowTransport::transport().loadedEndpoint(token);
 			p = ReplyPromise<T>(endpoint);
-			networkSender(p.getFuture(), endpoint);
+			networkSender(p.getFuture(), endpoint, FlowTransport::transport().loadedMessageType());
 		} else {
 			const auto& ep = p.getEndpoint().token;
 			serializer(ar, ep);
@@ -261,6 +262,7 @@ struct NetNotifiedQueue final : NotifiedQueue<T>, FlowReceiver, FastAllocated<Ne
 	  : NotifiedQueue<T>(futures, promises), FlowReceiver(remoteEndpoint, true) {}
 
 	void destroy() override { delete this; }
+	std::type_index messageType() const override { return typeid(T); }
 	void receive(ArenaObjectReader& reader) override {
 		this->addPromiseRef();
 		T message;
@@ -30,14 +30,23 @@
 #include "flow/flow.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
+// requestType is the type of the request the reply is for, the reply is sampled under it unless it is void
 ACTOR template <class T>
-void networkSender(Future<T> input, Endpoint endpoint) {
+void networkSender(Future<T> input, Endpoint endpoint, std::type_index requestType) {
+	state double startTime = now();
+	state bool sample = FLOW_KNOBS->ENDPOINT_LATENCY_HISTOGRAMS && requestType != typeid(void);
 	try {
 		T value = wait(input);
+		if (sample) {
+			FlowTransport::transport().sampleServiceLatency(requestType, now() - startTime);
+		}
 		FlowTransport::transport().sendUnreliable(SerializeSource<ErrorOr<EnsureTable<T>>>(value), endpoint, false);
 	} catch (Error& err) {
 		// if (err.code() == error_code_broken_promise) return;
 		ASSERT(err.code() != error_code_actor_cancelled);
+		if (sample) {
+			FlowTransport::transport().sampleServiceLatency(requestType, now() - startTime);
+		}
 		FlowTransport::transport().sendUnreliable(SerializeSource<ErrorOr<EnsureTable<T>>>(err), endpoint, false);
 	}
 }
@@ -232,6 +232,28 @@ ACTOR Future<Void> commitBatcher(ProxyCommitData* commitData,
 						continue;
 					}
 
+					// Hold back writes to storage servers that ratekeeper reports as falling behind, instead of
+					// having ratekeeper throttle every transaction in the cluster. Rejected clients retry with the
+					// same backoff as for proxy memory pressure, whose error they get since older clients would not
+					// retry a new one; the counter and trace event tell the two apart. Some writes always get
+					// through, so a server under full pressure slows its shards down rather than blocking them.
+					if (!commitData->storageWritePressure.empty()) {
+						double pressure = commitData->storageWritePressureFor(req.transaction);
+						if (deterministicRandom()->random01() <
+						    std::min(pressure,
+						             std::min(SERVER_KNOBS->RATEKEEPER_STORAGE_LOCAL_THROTTLE_MAX_REJECT, 0.99))) {
+							++commitData->stats.txnCommitErrors;
+							++commitData->stats.txnRejectedForStoragePressure;
+							req.reply.sendError(proxy_memory_limit_exceeded());
+							TraceEvent(SevWarn, "ProxyCommitStoragePressureRejected", commitData->dbgid)
+							    .suppressFor(60)
+							    .detail("Pressure", pressure)
+							    .detail("LocallyThrottledStorageServers", commitData->storageWritePressure.size())
+							    .detail("Rejected", commitData->stats.txnRejectedForStoragePressure.getValue());
+							continue;
+						}
+					}
+
 					if (bytes > FLOW_KNOBS->PACKET_WARNING) {
 						TraceEvent(!g_network->isSimulated() ? SevWarnAlways : SevWarn, "LargeTransaction")
 						    .suppressFor(1.0)
@@ -1763,9 +1785,10 @@ ACTOR Future<Void> proxyCheckSafeExclusion(Reference<AsyncVar<ServerDBInfo>> db,
 
 ACTOR Future<Void> reportTxnTagCommitCost(UID myID,
                                           Reference<AsyncVar<ServerDBInfo>> db,
-                                          UIDTransactionTagMap<TransactionCommitCostEstimation>* ssTrTagCommitCost) {
+                                          UIDTransactionTagMap<TransactionCommitCostEstimation>* ssTrTagCommitCost,
+                                          std::map<UID, double>* storageWritePressure) {
 	state Future<Void> nextRequestTimer = Never();
-	state Future<Void> nextReply = Never();
+	state Future<ReportCommitCostEstimationReply> nextReply = Never();
 	if (db->get().ratekeeper.present())
 		nextRequestTimer = Void();
 	loop choose {
@@ -1777,6 +1800,8 @@ ACTOR Future<Void> reportTxnTagCommitCost(UID myID,
 				TraceEvent("ProxyRatekeeperDied", myID);
 				nextRequestTimer = Never();
 			}
+			// Pressure from a previous ratekeeper is stale
+			storageWritePressure->clear();
 		}
 		when(wait(nextRequestTimer)) {
 			nextRequestTimer = Never();
@@ -1787,9 +1812,14 @@ ACTOR Future<Void> reportTxnTagCommitCost(UID myID,
 				nextReply = Never();
 			}
 		}
-		when(wait(nextReply)) {
+		when(ReportCommitCostEstimationReply reply = wait(nextReply)) {
 			nextReply = Never();
 			ssTrTagCommitCost->clear();
+			if (reply.storageWritePressure.size() != storageWritePressure->size()) {
+				TraceEvent("ProxyStorageWritePressureChanged", myID)
+				    .detail("StorageServers", reply.storageWritePressure.size());
+			}
+			*storageWritePressure = std::move(reply.storageWritePressure);
 			nextRequestTimer = delay(SERVER_KNOBS->REPORT_TRANSACTION_COST_ESTIMATION_DELAY);
 		}
 	}
@@ -1862,7 +1892,8 @@ ACTOR Future<Void> commitProxyServerCore(CommitProxyInterface proxy,
 	addActor.send(readRequestServer(proxy, addActor, &commitData));
 	addActor.send(rejoinServer(proxy, &commitData));
 	addActor.send(ddMetricsRequestServer(proxy, db));
-	addActor.send(reportTxnTagCommitCost(proxy.id(), db, &commitData.ssTrTagCommitCost));
+	addActor.send(
+	    reportTxnTagCommitCost(proxy.id(), db, &commitData.ssTrTagCommitCost, &commitData.storageWritePressure));
 
 	// wait for txnStateStore recovery
 	wait(success(commitData.txnStateStore->readValue(StringRef())));
@@ -251,6 +251,19 @@ public:
 		return (physicalBytes + (inflightPenalty * inFlightBytes)) * availableSpaceMultiplier;
 	}
 
+	// Reads can be served by any member of the team, so the team's read load is the average of its servers'
+	int64_t getLoadReadBandwidth() const override {
+		int64_t sum = 0;
+		int added = 0;
+		for (const auto& server : servers) {
+			if (server->serverMetrics.present()) {
+				added++;
+				sum += server->serverMetrics.get().load.bytesReadPerKSecond;
+			}
+		}
+		return added == 0 ? 0 : sum / added;
+	}
+
 	int64_t getMinAvailableSpace(bool includeInFlight = true) const override {
 		int64_t minAvailableSpace = std::numeric_limits<int64_t>::max();
 		for (const auto& server : servers) {
@@ -927,7 +940,9 @@ struct DDTeamCollection : ReferenceCounted<DDTeamCollection> {
 					if (self->teams[currentIndex]->isHealthy() &&
 					    (!req.preferLowerUtilization ||
 					     self->teams[currentIndex]->hasHealthyAvailableSpace(self->medianAvailableSpace))) {
-						int64_t loadBytes = self->teams[currentIndex]->getLoadBytes(true, req.inflightPenalty);
+						int64_t loadBytes = req.useReadLoad
+						                        ? self->teams[currentIndex]->getLoadReadBandwidth()
+						                        : self->teams[currentIndex]->getLoadBytes(true, req.inflightPenalty);
 						if ((!bestOption.present() || (req.preferLowerUtilization && loadBytes < bestLoadBytes) ||
 						     (!req.preferLowerUtilization && loadBytes > bestLoadBytes)) &&
 						    (!req.teamMustHaveShards ||
@@ -974,7 +989,8 @@ struct DDTeamCollection : ReferenceCounted<DDTeamCollection> {
 				}
 
 				for (int i = 0; i < randomTeams.size(); i++) {
-					int64_t loadBytes = randomTeams[i]->getLoadBytes(true, req.inflightPenalty);
+					int64_t loadBytes = req.useReadLoad ? randomTeams[i]->getLoadReadBandwidth()
+					                                    : randomTeams[i]->getLoadBytes(true, req.inflightPenalty);
 					if (!bestOption.present() || (req.preferLowerUtilization && loadBytes < bestLoadBytes) ||
 					    (!req.preferLowerUtilization && loadBytes > bestLoadBytes)) {
 						bestLoadBytes = loadBytes;
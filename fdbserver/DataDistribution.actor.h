@@ -32,9 +32,11 @@
 struct RelocateShard {
 	KeyRange keys;
 	int priority;
+	bool useReadLoad; // Choose the destination by read bandwidth rather than by bytes, see BgDDReadLoadBalancer
 
-	RelocateShard() : priority(0) {}
-	RelocateShard(KeyRange const& keys, int priority) : keys(keys), priority(priority) {}
+	RelocateShard() : priority(0), useReadLoad(false) {}
+	RelocateShard(KeyRange const& keys, int priority, bool useReadLoad = false)
+	  : keys(keys), priority(priority), useReadLoad(useReadLoad) {}
 };
 
 struct IDataDistributionTeam {
@@ -44,6 +46,7 @@ struct IDataDistributionTeam {
 	virtual void addDataInFlightToTeam(int64_t delta) = 0;
 	virtual int64_t getDataInFlightToTeam() const = 0;
 	virtual int64_t getLoadBytes(bool includeInFlight = true, double inflightPenalty = 1.0) const = 0;
+	virtual int64_t getLoadReadBandwidth() const = 0;
 	virtual int64_t getMinAvailableSpace(bool includeInFlight = true) const = 0;
 	virtual double getMinAvailableSpaceRatio(bool includeInFlight = true) const = 0;
 	virtual bool hasHealthyAvailableSpace(double minRatio) const = 0;
@@ -79,6 +82,7 @@ struct GetTeamRequest {
 	bool preferLowerUtilization;
 	bool teamMustHaveShards;
 	double inflightPenalty;
+	bool useReadLoad = false; // Rank teams by read bandwidth instead of by bytes
 	std::vector<UID> completeSources;
 	std::vector<UID> src;
 	Promise<std::pair<Optional<Reference<IDataDistributionTeam>>, bool>> reply;
@@ -97,7 +101,7 @@ struct GetTeamRequest {
 
 		ss << "WantsNewServers:" << wantsNewServers << " WantsTrueBest:" << wantsTrueBest
 		   << " PreferLowerUtilization:" << preferLowerUtilization << " teamMustHaveShards:" << teamMustHaveShards
-		   << " inflightPenalty:" << inflightPenalty << ";";
+		   << " inflightPenalty:" << inflightPenalty << " useReadLoad:" << useReadLoad << ";";
 		ss << "CompleteSources:";
 		for (const auto& cs : completeSources) {
 			ss << cs.toString() << ",";
@@ -47,11 +47,12 @@ struct RelocateData {
 	std::vector<UID> src;
 	std::vector<UID> completeSources;
 	bool wantsNewServers;
+	bool useReadLoad;
 	TraceInterval interval;
 
 	RelocateData()
 	  : startTime(-1), priority(-1), boundaryPriority(-1), healthPriority(-1), workFactor(0), wantsNewServers(false),
-	    interval("QueuedRelocation") {}
+	    useReadLoad(false), interval("QueuedRelocation") {}
 	explicit RelocateData(RelocateShard const& rs)
 	  : keys(rs.keys), priority(rs.priority), boundaryPriority(isBoundaryPriority(rs.priority) ? rs.priority : -1),
 	    healthPriority(isHealthPriority(rs.priority) ? rs.priority : -1), startTime(now()),
@@ -60,7 +61,7 @@ struct RelocateData {
 	                    rs.priority == SERVER_KNOBS->PRIORITY_REBALANCE_UNDERUTILIZED_TEAM ||
 	                    rs.priority == SERVER_KNOBS->PRIORITY_SPLIT_SHARD ||
 	                    rs.priority == SERVER_KNOBS->PRIORITY_TEAM_REDUNDANT),
-	    interval("QueuedRelocation") {}
+	    useReadLoad(rs.useReadLoad), interval("QueuedRelocation") {}
 
 	static bool isHealthPriority(int priority) {
 		return priority == SERVER_KNOBS->PRIORITY_POPULATE_REGION ||
@@ -84,7 +85,7 @@ struct RelocateData {
 		return priority == rhs.priority && boundaryPriority == rhs.boundaryPriority &&
 		       healthPriority == rhs.healthPriority && keys == rhs.keys && startTime == rhs.startTime &&
 		       workFactor == rhs.workFactor && src == rhs.src && completeSources == rhs.completeSources &&
-		       wantsNewServers == rhs.wantsNewServers && randomId == rhs.randomId;
+		       wantsNewServers == rhs.wantsNewServers && useReadLoad == rhs.useReadLoad && randomId == rhs.randomId;
 	}
 	bool operator!=(const RelocateData& rhs) const { return !(*this == rhs); }
 };
@@ -171,6 +172,10 @@ public:
 		});
 	}
 
+	int64_t getLoadReadBandwidth() const override {
+		return sum([](IDataDistributionTeam const& team) { return team.getLoadReadBandwidth(); });
+	}
+
 	int64_t getMinAvailableSpace(bool includeInFlight = true) const override {
 		int64_t result = std::numeric_limits<int64_t>::max();
 		for (const auto& team : teams) {
@@ -369,6 +374,9 @@ struct DDQueueData {
 	int activeRelocations;
 	int queuedRelocations;
 	int64_t bytesWritten;
+	int64_t moveKeysTransactions; // System keyspace transactions committed by moveKeys()
+	int64_t batchedRelocations; // Relocations launched for several adjacent queued shards at once
+	int64_t batchedShards; // Queued shards launched as part of a batched relocation
 	int teamSize;
 	int singleRegionTeamSize;
 
@@ -448,7 +456,8 @@ struct DDQueueData {
 	            FutureStream<RelocateShard> input,
 	            PromiseStream<GetMetricsRequest> getShardMetrics,
 	            double* lastLimited)
-	  : activeRelocations(0), queuedRelocations(0), bytesWritten(0), teamCollections(teamCollections),
+	  : activeRelocations(0), queuedRelocations(0), bytesWritten(0), moveKeysTransactions(0), batchedRelocations(0),
+	    batchedShards(0), teamCollections(teamCollections),
 	    shardsAffectedByTeamFailure(sABTF), getAverageShardBytes(getAverageShardBytes), distributorId(mid), lock(lock),
 	    cx(cx), teamSize(teamSize), singleRegionTeamSize(singleRegionTeamSize), output(output), input(input),
 	    getShardMetrics(getShardMetrics), startMoveKeysParallelismLock(SERVER_KNOBS->DD_MOVE_KEYS_PARALLELISM),
@@ -678,6 +687,8 @@ struct DDQueueData {
 			//  make sure that we keep the relocation intent for the job that we queue up
 			if (foundActiveFetching || foundActiveRelocation) {
 				rd.wantsNewServers |= rrs.wantsNewServers;
+				// Only a move that is purely a read rebalance is placed by read bandwidth
+				rd.useReadLoad = rd.useReadLoad && rrs.useReadLoad;
 				rd.startTime = std::min(rd.startTime, rrs.startTime);
 				if (!hasHealthPriority) {
 					rd.healthPriority = std::max(rd.healthPriority, rrs.healthPriority);
@@ -834,6 +845,70 @@ struct DDQueueData {
 		launchQueuedWork(combined, ddEnabledState);
 	}
 
+	// Whether the queued relocation other, for a range adjacent to rd's, can be launched as part of rd
+	bool canBatchWith(const RelocateData& rd, const RelocateData& other) {
+		if (other.src.empty() || !queue[other.src[0]].count(other) || other.priority != rd.priority ||
+		    other.healthPriority != rd.healthPriority || other.boundaryPriority != rd.boundaryPriority ||
+		    other.wantsNewServers != rd.wantsNewServers || other.useReadLoad != rd.useReadLoad || other.src != rd.src ||
+		    std::set<UID>(other.completeSources.begin(), other.completeSources.end()) !=
+		        std::set<UID>(rd.completeSources.begin(), rd.completeSources.end())) {
+			return false;
+		}
+		auto intersectingInFlight = inFlight.intersectingRanges(other.keys);
+		for (auto it = intersectingInFlight.begin(); it != intersectingInFlight.end(); ++it) {
+			if (inFlightActors.liveActorAt(it->range().begin)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void removeBatchedRelocation(const RelocateData& other) {
+		for (int i = 0; i < other.src.size(); i++) {
+			ASSERT(queue[other.src[i]].erase(other));
+		}
+		queuedRelocations--;
+		finishRelocation(other.priority, other.healthPriority);
+	}
+
+	// Extends rd, which is being launched, over queued relocations of adjacent shards with the same source servers, so
+	// that a single moveKeys() moves them all.  The system keyspace transactions of a move cover every shard in its
+	// range, so a host drain made of many small shards needs a fraction of the transactions it would otherwise.  Only
+	// moves driven by team health are batched, since balancing and split moves choose a destination per shard.
+	void batchAdjacentRelocations(RelocateData& rd) {
+		if (SERVER_KNOBS->DD_MOVE_KEYS_BATCH_SHARDS <= 1 || !RelocateData::isHealthPriority(rd.priority)) {
+			return;
+		}
+
+		int shards = 1;
+		while (shards < SERVER_KNOBS->DD_MOVE_KEYS_BATCH_SHARDS && rd.keys.end < allKeys.end) {
+			auto next = queueMap.rangeContaining(rd.keys.end);
+			if (next->range() != next->value().keys || !canBatchWith(rd, next->value())) {
+				break;
+			}
+			removeBatchedRelocation(next->value());
+			rd.startTime = std::min(rd.startTime, next->value().startTime);
+			rd.keys = KeyRangeRef(rd.keys.begin, next->range().end);
+			shards++;
+		}
+		while (shards < SERVER_KNOBS->DD_MOVE_KEYS_BATCH_SHARDS && rd.keys.begin > allKeys.begin) {
+			auto prev = queueMap.rangeContainingKeyBefore(rd.keys.begin);
+			if (prev->range() != prev->value().keys || !canBatchWith(rd, prev->value())) {
+				break;
+			}
+			removeBatchedRelocation(prev->value());
+			rd.startTime = std::min(rd.startTime, prev->value().startTime);
+			rd.keys = KeyRangeRef(prev->range().begin, rd.keys.end);
+			shards++;
+		}
+
+		if (shards > 1) {
+			TEST(true); // Batched relocation of adjacent shards
+			batchedRelocations++;
+			batchedShards += shards;
+		}
+	}
+
 	// For each relocateData rd in the queue, check if there exist inflight relocate data whose keyrange is overlapped
 	// with rd. If there exist, cancel them by cancelling their actors and reducing the src servers' busyness of those
 	// canceled inflight relocateData. Launch the relocation for the rd.
@@ -846,6 +921,11 @@ struct DDQueueData {
 		for (; it != combined.end(); it++) {
 			RelocateData rd(*it);
 
+			// Skip relocations that were launched as part of a batch earlier in this loop
+			if (rd.src.empty() || !queue[rd.src[0]].count(rd)) {
+				continue;
+			}
+
 			// Check if there is an inflight shard that is overlapped with the queued relocateShard (rd)
 			bool overlappingInFlight = false;
 			auto intersectingInFlight = inFlight.intersectingRanges(rd.keys);
@@ -899,6 +979,7 @@ struct DDQueueData {
 			for (int i = 0; i < rd.src.size(); i++) {
 				ASSERT(queue[rd.src[i]].erase(rd));
 			}
+			batchAdjacentRelocations(rd);
 
 			// If there is a job in flight that wants data relocation which we are about to cancel/modify,
 			//     make sure that we keep the relocation intent for the job that we launch
@@ -906,6 +987,7 @@ struct DDQueueData {
 			for (auto it = f.begin(); it != f.end(); ++it) {
 				if (inFlightActors.liveActorAt(it->range().begin)) {
 					rd.wantsNewServers |= it->value().wantsNewServers;
+					rd.useReadLoad = rd.useReadLoad && it->value().useReadLoad;
 				}
 			}
 			startedHere++;
@@ -1005,11 +1087,15 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueueData* self, RelocateData rd,
 					    rd.healthPriority == SERVER_KNOBS->PRIORITY_TEAM_0_LEFT)
 						inflightPenalty = SERVER_KNOBS->INFLIGHT_PENALTY_ONE_LEFT;
 
+					// A read rebalance checked its move against the team with the least read bandwidth, so it must
+					// land on that team rather than on one chosen by bytes
 					auto req = GetTeamRequest(rd.wantsNewServers,
-					                          rd.priority == SERVER_KNOBS->PRIORITY_REBALANCE_UNDERUTILIZED_TEAM,
+					                          rd.priority == SERVER_KNOBS->PRIORITY_REBALANCE_UNDERUTILIZED_TEAM ||
+					                              rd.useReadLoad,
 					                          true,
 					                          false,
 					                          inflightPenalty);
+					req.useReadLoad = rd.useReadLoad;
 					req.src = rd.src;
 					req.completeSources = rd.completeSources;
 					// bestTeam.second = false if the bestTeam in the teamCollection (in the DC) does not have any
@@ -1135,7 +1221,8 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueueData* self, RelocateData rd,
 			                                         &self->finishMoveKeysParallelismLock,
 			                                         self->teamCollections.size() > 1,
 			                                         relocateShardInterval.pairID,
-			                                         ddEnabledState);
+			                                         ddEnabledState,
+			                                         &self->moveKeysTransactions);
 			state Future<Void> pollHealth =
 			    signalledTransferComplete ? Never()
 			                              : delay(SERVER_KNOBS->HEALTH_POLL_TIME, TaskPriority::DataDistributionLaunch);
@@ -1158,7 +1245,8 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueueData* self, RelocateData rd,
 								                      &self->finishMoveKeysParallelismLock,
 								                      self->teamCollections.size() > 1,
 								                      relocateShardInterval.pairID,
-								                      ddEnabledState);
+								                      ddEnabledState,
+								                      &self->moveKeysTransactions);
 							} else {
 								self->fetchKeysComplete.insert(rd);
 								break;
@@ -1331,6 +1419,153 @@ ACTOR Future<bool> rebalanceTeams(DDQueueData* self,
 	return false;
 }
 
+// Move the read-hottest of a sample of sourceTeam's shards to destTeam if sourceTeam serves much more read bandwidth
+// than destTeam.  The shard must be small enough relative to the difference that the move cannot make destTeam the
+// hotter of the two, so that a hot shard does not bounce back and forth between teams.
+ACTOR Future<bool> rebalanceReadLoad(DDQueueData* self,
+                                     int priority,
+                                     Reference<IDataDistributionTeam> sourceTeam,
+                                     Reference<IDataDistributionTeam> destTeam,
+                                     bool primary,
+                                     TraceEvent* traceEvent) {
+	if (g_network->isSimulated() && g_simulator.speedUpSimulation) {
+		traceEvent->detail("CancelingDueToSimulationSpeedup", true);
+		return false;
+	}
+
+	state int64_t sourceRead = sourceTeam->getLoadReadBandwidth();
+	state int64_t destRead = destTeam->getLoadReadBandwidth();
+	traceEvent->detail("SourceReadBandwidth", sourceRead).detail("DestReadBandwidth", destRead);
+
+	if (sourceRead < SERVER_KNOBS->DD_READ_REBALANCE_MIN_BYTES_PER_KSEC ||
+	    sourceRead <= destRead * SERVER_KNOBS->DD_READ_REBALANCE_DIFF_RATIO) {
+		return false;
+	}
+
+	state std::vector<KeyRange> shards = self->shardsAffectedByTeamFailure->getShardsFor(
+	    ShardsAffectedByTeamFailure::Team(sourceTeam->getServerIDs(), primary));
+	traceEvent->detail("ShardsInSource", shards.size());
+	if (!shards.size())
+		return false;
+
+	// Half the difference moves the two teams to the same load, anything more only moves the hot spot
+	state int64_t maxShardRead = (sourceRead - destRead) / 2;
+	state KeyRange moveShard;
+	state StorageMetrics metrics;
+	state int retries = 0;
+	while (retries < SERVER_KNOBS->DD_READ_REBALANCE_SHARD_SAMPLES) {
+		state KeyRange testShard = deterministicRandom()->randomChoice(shards);
+		StorageMetrics testMetrics =
+		    wait(brokenPromiseToNever(self->getShardMetrics.getReply(GetMetricsRequest(testShard))));
+		if (testMetrics.bytesReadPerKSecond > metrics.bytesReadPerKSecond &&
+		    testMetrics.bytesReadPerKSecond <= maxShardRead) {
+			moveShard = testShard;
+			metrics = testMetrics;
+		}
+		retries++;
+	}
+
+	traceEvent->detail("ShardReadBandwidth", metrics.bytesReadPerKSecond).detail("ShardBytes", metrics.bytes);
+	if (metrics.bytesReadPerKSecond == 0) {
+		return false;
+	}
+
+	// Verify the shard is still in ShardsAffectedByTeamFailure
+	shards = self->shardsAffectedByTeamFailure->getShardsFor(
+	    ShardsAffectedByTeamFailure::Team(sourceTeam->getServerIDs(), primary));
+	for (int i = 0; i < shards.size(); i++) {
+		if (moveShard == shards[i]) {
+			traceEvent->detail("ShardStillPresent", true);
+			self->output.send(RelocateShard(moveShard, priority, true));
+			return true;
+		}
+	}
+
+	traceEvent->detail("ShardStillPresent", false);
+	return false;
+}
+
+// Moves read-hot shards from the team serving the most read bandwidth to the team serving the least.  Byte balancing
+// is left to BgDDMountainChopper and BgDDValleyFiller; shards moved here count against the same parallelism limit.
+ACTOR Future<Void> BgDDReadLoadBalancer(DDQueueData* self, int teamCollectionIndex) {
+	state Transaction tr(self->cx);
+	state double lastRead = 0;
+	state bool skipCurrentLoop = false;
+	state Reference<IDataDistributionTeam> sourceTeam;
+	state bool movedLast = false;
+	loop {
+		state bool moved = false;
+		state TraceEvent traceEvent("BgDDReadLoadBalancer", self->distributorId);
+		traceEvent.suppressFor(5.0);
+
+		try {
+			// Read bandwidth is averaged over a window, so after a move wait for the teams' metrics to reflect it
+			// rather than moving more shards off the same team based on stale numbers.
+			state Future<Void> delayF =
+			    delay(movedLast ? SERVER_KNOBS->DD_READ_REBALANCE_COOLDOWN : SERVER_KNOBS->DD_READ_REBALANCE_INTERVAL,
+			          TaskPriority::DataDistributionLaunch);
+			if ((now() - lastRead) > SERVER_KNOBS->BG_REBALANCE_SWITCH_CHECK_INTERVAL) {
+				tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+				Optional<Value> val = wait(tr.get(rebalanceDDIgnoreKey));
+				lastRead = now();
+				skipCurrentLoop = val.present();
+			}
+
+			traceEvent.detail("Enabled", !skipCurrentLoop && SERVER_KNOBS->DD_READ_REBALANCE);
+
+			wait(delayF);
+			if (skipCurrentLoop || !SERVER_KNOBS->DD_READ_REBALANCE) {
+				continue;
+			}
+
+			traceEvent.detail("QueuedRelocations",
+			                  self->priority_relocations[SERVER_KNOBS->PRIORITY_REBALANCE_OVERUTILIZED_TEAM]);
+			if (self->priority_relocations[SERVER_KNOBS->PRIORITY_REBALANCE_OVERUTILIZED_TEAM] <
+			    SERVER_KNOBS->DD_REBALANCE_PARALLELISM) {
+				GetTeamRequest sourceReq(true, true, false, true);
+				sourceReq.useReadLoad = true;
+				std::pair<Optional<Reference<IDataDistributionTeam>>, bool> hotTeam = wait(brokenPromiseToNever(
+				    self->teamCollections[teamCollectionIndex].getTeam.getReply(sourceReq)));
+				traceEvent.detail("SourceTeam",
+				                  printable(hotTeam.first.map<std::string>(
+				                      [](const Reference<IDataDistributionTeam>& team) { return team->getDesc(); })));
+
+				if (hotTeam.first.present()) {
+					sourceTeam = hotTeam.first.get();
+					GetTeamRequest destReq(true, true, true, false);
+					destReq.useReadLoad = true;
+					std::pair<Optional<Reference<IDataDistributionTeam>>, bool> coldTeam = wait(brokenPromiseToNever(
+					    self->teamCollections[teamCollectionIndex].getTeam.getReply(destReq)));
+					traceEvent.detail(
+					    "DestTeam",
+					    printable(coldTeam.first.map<std::string>(
+					        [](const Reference<IDataDistributionTeam>& team) { return team->getDesc(); })));
+
+					if (coldTeam.first.present() && coldTeam.first.get()->getServerIDs() != sourceTeam->getServerIDs()) {
+						bool _moved = wait(rebalanceReadLoad(self,
+						                                     SERVER_KNOBS->PRIORITY_REBALANCE_OVERUTILIZED_TEAM,
+						                                     sourceTeam,
+						                                     coldTeam.first.get(),
+						                                     teamCollectionIndex == 0,
+						                                     &traceEvent));
+						moved = _moved;
+					}
+				}
+			}
+
+			tr.reset();
+		} catch (Error& e) {
+			traceEvent.error(
+			    e, true); // Log actor_cancelled because it's not legal to suppress an event that's initialized
+			wait(tr.onError(e));
+		}
+
+		traceEvent.detail("Moved", moved);
+		traceEvent.log();
+		movedLast = moved;
+	}
+}
+
 ACTOR Future<Void> BgDDMountainChopper(DDQueueData* self, int teamCollectionIndex) {
 	state double rebalancePollingInterval = SERVER_KNOBS->BG_REBALANCE_POLLING_INTERVAL;
 	state int resetCount = SERVER_KNOBS->DD_REBALANCE_RESET_AMOUNT;
@@ -1582,6 +1817,8 @@ ACTOR Future<Void> dataDistributionQueue(Database cx,
 	for (int i = 0; i < teamCollections.size(); i++) {
 		balancingFutures.push_back(BgDDMountainChopper(&self, i));
 		balancingFutures.push_back(BgDDValleyFiller(&self, i));
+		// Checks DD_READ_REBALANCE on each pass, so that workloads can turn it on in a running cluster
+		balancingFutures.push_back(BgDDReadLoadBalancer(&self, i));
 	}
 	balancingFutures.push_back(delayedAsyncVar(self.rawProcessingUnhealthy, processingUnhealthy, 0));
 
@@ -1657,6 +1894,11 @@ ACTOR Future<Void> dataDistributionQueue(Database cx,
 					    .detail("UnhealthyRelocations", self.unhealthyRelocations)
 					    .detail("HighestPriority", highestPriorityRelocation)
 					    .detail("BytesWritten", self.bytesWritten)
+					    .detail("MoveKeysTransactions", self.moveKeysTransactions)
+					    .detail("MoveKeysTransactionsPerMB",
+					            self.bytesWritten > 0 ? self.moveKeysTransactions * 1e6 / self.bytesWritten : 0.0)
+					    .detail("BatchedRelocations", self.batchedRelocations)
+					    .detail("BatchedShards", self.batchedShards)
 					    .detail("PriorityRecoverMove", self.priority_relocations[SERVER_KNOBS->PRIORITY_RECOVER_MOVE])
 					    .detail("PriorityRebalanceUnderutilizedTeam",
 					            self.priority_relocations[SERVER_KNOBS->PRIORITY_REBALANCE_UNDERUTILIZED_TEAM])
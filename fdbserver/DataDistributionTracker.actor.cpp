@@ -87,6 +87,9 @@ struct DataDistributionTracker {
 	// Read hot detection
 	PromiseStream<KeyRange> readHotShard;
 
+	// Number of shards removed by shardCoalescer since the tracker started
+	int64_t coalescedShards;
+
 	// The reference to trackerCancelled must be extracted by actors,
 	// because by the time (trackerCancelled == true) this memory cannot
 	// be accessed
@@ -126,7 +129,7 @@ struct DataDistributionTracker {
 	  : cx(cx), distributorId(distributorId), dbSizeEstimate(new AsyncVar<int64_t>()), systemSizeEstimate(0),
 	    maxShardSize(new AsyncVar<Optional<int64_t>>()), sizeChanges(false), readyToStart(readyToStart), output(output),
 	    shardsAffectedByTeamFailure(shardsAffectedByTeamFailure), anyZeroHealthyTeams(anyZeroHealthyTeams),
-	    shards(shards), trackerCancelled(trackerCancelled) {}
+	    shards(shards), coalescedShards(0), trackerCancelled(trackerCancelled) {}
 
 	~DataDistributionTracker() {
 		trackerCancelled = true;
@@ -674,6 +677,132 @@ Future<Void> shardMerger(DataDistributionTracker* self,
 	return Void();
 }
 
+struct ShardCoalescePlan {
+	KeyRange keys;
+	StorageMetrics metrics;
+	double lastLowBandwidthStartTime;
+	int shardCount; // number of non-splittable shards aggregated, as in ShardMetrics
+	int shardsMerged; // number of entries in self->shards folded into keys
+
+	ShardCoalescePlan(KeyRange const& keys, ShardMetrics const& m)
+	  : keys(keys), metrics(m.metrics), lastLowBandwidthStartTime(m.lastLowBandwidthStartTime),
+	    shardCount(m.shardCount), shardsMerged(1) {}
+};
+
+// Scans up to DD_SHARD_COALESCE_SCAN_BATCH shards starting with the one containing begin, and appends to plans every
+// run of contiguous shards that have been cold for DD_LOW_BANDWIDTH_DELAY, are not in flight, are served by exactly
+// the same teams, and would still be under the minimum shard size once merged. Runs never span systemKeys.begin, so
+// the system size estimate is unaffected. Returns the key to resume from, or allKeys.begin after the last shard.
+Key planShardCoalesce(DataDistributionTracker* self, Key begin, std::vector<ShardCoalescePlan>& plans) {
+	int64_t maxShardSize = self->maxShardSize->get().get();
+	Optional<ShardCoalescePlan> run;
+	std::pair<vector<ShardsAffectedByTeamFailure::Team>, vector<ShardsAffectedByTeamFailure::Team>> runTeams;
+	auto finishRun = [&]() {
+		if (run.present() && run.get().shardsMerged > 1) {
+			plans.push_back(run.get());
+		}
+		run.reset();
+	};
+
+	auto it = self->shards.rangeContaining(begin);
+	auto end = self->shards.ranges().end();
+	for (int scanned = 0; it != end && scanned < SERVER_KNOBS->DD_SHARD_COALESCE_SCAN_BATCH; ++it, ++scanned) {
+		KeyRange keys = it->range();
+		Optional<ShardMetrics> metrics = it->value().stats->get();
+		// The first shard is allowed to be arbitrarily small, so it never needs merging.
+		if (!metrics.present() || keys.begin == allKeys.begin ||
+		    getBandwidthStatus(metrics.get().metrics) != BandwidthStatusLow ||
+		    now() - metrics.get().lastLowBandwidthStartTime < SERVER_KNOBS->DD_LOW_BANDWIDTH_DELAY ||
+		    metrics.get().metrics.bytes >= getShardSizeBounds(keys, maxShardSize).min.bytes) {
+			finishRun();
+			continue;
+		}
+
+		auto teams = self->shardsAffectedByTeamFailure->getTeamsFor(keys);
+		if (!teams.second.empty()) {
+			// In flight; wait for the move to finish so the merged shard has a single set of sources
+			finishRun();
+			continue;
+		}
+
+		if (run.present()) {
+			ShardCoalescePlan& r = run.get();
+			KeyRangeRef merged(r.keys.begin, keys.end);
+			if (teams == runTeams && (keys.begin >= systemKeys.begin) == (r.keys.begin >= systemKeys.begin) &&
+			    r.shardsMerged < SERVER_KNOBS->DD_SHARD_COALESCE_MAX_SHARDS &&
+			    r.shardCount + metrics.get().shardCount < CLIENT_KNOBS->SHARD_COUNT_LIMIT &&
+			    r.metrics.bytes + metrics.get().metrics.bytes < getShardSizeBounds(merged, maxShardSize).min.bytes) {
+				r.keys = merged;
+				r.metrics += metrics.get().metrics;
+				r.lastLowBandwidthStartTime =
+				    std::max(r.lastLowBandwidthStartTime, metrics.get().lastLowBandwidthStartTime);
+				r.shardCount += metrics.get().shardCount;
+				r.shardsMerged++;
+				continue;
+			}
+			finishRun();
+		}
+		run = ShardCoalescePlan(keys, metrics.get());
+		runTeams = teams;
+	}
+	finishRun();
+
+	return it == end ? allKeys.begin : it->range().begin;
+}
+
+// Unlike shardMerger, which only acts once a single shard has wanted to merge for DD_MERGE_COALESCE_DELAY, this
+// periodically sweeps the whole shard map and merges whole runs of small cold shards at once. This keeps the shard
+// count (and with it keyServers, proxy keyInfo and client location caches) from growing without bound after large
+// clears.
+ACTOR Future<Void> shardCoalescer(DataDistributionTracker* self) {
+	state Key begin;
+	state int64_t removedInPass;
+	state int mergesInPass;
+	state double passStart;
+
+	wait(self->readyToStart.getFuture());
+	loop {
+		wait(delay(SERVER_KNOBS->DD_SHARD_COALESCE_INTERVAL, TaskPriority::DataDistributionLow));
+		if (self->anyZeroHealthyTeams->get() || !self->maxShardSize->get().present()) {
+			continue;
+		}
+
+		begin = allKeys.begin;
+		removedInPass = 0;
+		mergesInPass = 0;
+		passStart = now();
+		loop {
+			std::vector<ShardCoalescePlan> plans;
+			begin = planShardCoalesce(self, begin, plans);
+			for (auto& p : plans) {
+				TraceEvent("RelocateShardCoalesce", self->distributorId)
+				    .detail("Keys", p.keys)
+				    .detail("EndingSize", p.metrics.bytes)
+				    .detail("BatchedMerges", p.shardsMerged)
+				    .detail("ShardCount", p.shardCount);
+				restartShardTrackers(
+				    self, p.keys, ShardMetrics(p.metrics, p.lastLowBandwidthStartTime, p.shardCount));
+				self->shardsAffectedByTeamFailure->defineShard(p.keys);
+				self->output.send(RelocateShard(p.keys, SERVER_KNOBS->PRIORITY_MERGE_SHARD));
+				self->coalescedShards += p.shardsMerged - 1;
+				removedInPass += p.shardsMerged - 1;
+				mergesInPass++;
+			}
+			if (begin == allKeys.begin || self->anyZeroHealthyTeams->get()) {
+				break;
+			}
+			wait(delay(0, TaskPriority::DataDistributionLow));
+		}
+
+		TraceEvent("ShardCoalescePass", self->distributorId)
+		    .detail("Merges", mergesInPass)
+		    .detail("ShardsRemoved", removedInPass)
+		    .detail("Shards", self->shards.size())
+		    .detail("Duration", now() - passStart)
+		    .detail("Completed", begin == allKeys.begin);
+	}
+}
+
 ACTOR Future<Void> shardEvaluator(DataDistributionTracker* self,
                                   KeyRange keys,
                                   Reference<AsyncVar<Optional<ShardMetrics>>> shardSize,
@@ -933,6 +1062,9 @@ ACTOR Future<Void> dataDistributionTracker(Reference<InitialDataDistribution> in
 	                                   *trackerCancelled);
 	state Future<Void> loggingTrigger = Void();
 	state Future<Void> readHotDetect = readHotDetector(&self);
+	state Future<Void> coalescer = SERVER_KNOBS->DD_SHARD_COALESCE ? shardCoalescer(&self) : Never();
+	state int64_t lastCoalescedShards = 0;
+	state double lastLoggingTime = now();
 	try {
 		wait(trackInitialShards(&self, initData));
 		initData = Reference<InitialDataDistribution>();
@@ -942,11 +1074,17 @@ ACTOR Future<Void> dataDistributionTracker(Reference<InitialDataDistribution> in
 				req.send(self.maxShardSize->get().get() / 2);
 			}
 			when(wait(loggingTrigger)) {
+				double elapsed = now() - lastLoggingTime;
 				TraceEvent("DDTrackerStats", self.distributorId)
 				    .detail("Shards", self.shards.size())
 				    .detail("TotalSizeBytes", self.dbSizeEstimate->get())
 				    .detail("SystemSizeBytes", self.systemSizeEstimate)
+				    .detail("CoalescedShards", self.coalescedShards)
+				    .detail("CoalescedShardsHz",
+				            elapsed > 0 ? (self.coalescedShards - lastCoalescedShards) / elapsed : 0.0)
 				    .trackLatest("DDTrackerStats");
+				lastCoalescedShards = self.coalescedShards;
+				lastLoggingTime = now();
 
 				loggingTrigger = delay(SERVER_KNOBS->DATA_DISTRIBUTION_LOGGING_INTERVAL, TaskPriority::FlushTrace);
 			}
@@ -957,6 +1095,7 @@ ACTOR Future<Void> dataDistributionTracker(Reference<InitialDataDistribution> in
 				self.sizeChanges.add(fetchShardMetricsList(&self, req));
 			}
 			when(wait(self.sizeChanges.getResult())) {}
+			when(wait(coalescer)) {}
 		}
 	} catch (Error& e) {
 		TraceEvent(SevError, "DataDistributionTrackerError", self.distributorId).error(e);
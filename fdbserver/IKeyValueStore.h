@@ -47,6 +47,16 @@ public:
 	virtual Future<Void> commit(
 	    bool sequential = false) = 0; // returns when prior sets and clears are (atomically) durable
 
+	// Writes a block of key-value pairs, sorted by key, into a key range that holds no other data (e.g. a block of a
+	// shard being fetched).  Like set(), the pairs become durable with the next commit().  Stores that return true
+	// from supportsBulkLoad() load the block without going through their write path for each pair.
+	virtual void setBulk(Standalone<RangeResultRef> const& block) {
+		for (auto& kv : block) {
+			set(kv, &block.arena());
+		}
+	}
+	virtual bool supportsBulkLoad() const { return false; }
+
 	virtual Future<Optional<Value>> readValue(KeyRef key, Optional<UID> debugID = Optional<UID>()) = 0;
 
 	// Like readValue(), but returns only the first maxLength bytes of the value if it is longer
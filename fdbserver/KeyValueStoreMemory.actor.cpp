@@ -84,9 +84,11 @@ public:
 		int64_t uncommittedBytes = queue.totalSize() + transactionSize;
 
 		// Check that we have enough space in memory and on disk
-		int64_t freeSize = std::min(getAvailableSize(), diskQueueBytes.free / 4 - uncommittedBytes);
-		int64_t availableSize = std::min(getAvailableSize(), diskQueueBytes.available / 4 - uncommittedBytes);
-		int64_t totalSize = std::min(memoryLimit, diskQueueBytes.total / 4 - uncommittedBytes);
+		double overhead = diskQueueBytesPerDataByte();
+		int64_t freeSize = std::min(getAvailableSize(), int64_t(diskQueueBytes.free / overhead) - uncommittedBytes);
+		int64_t availableSize =
+		    std::min(getAvailableSize(), int64_t(diskQueueBytes.available / overhead) - uncommittedBytes);
+		int64_t totalSize = std::min(memoryLimit, int64_t(diskQueueBytes.total / overhead) - uncommittedBytes);
 
 		return StorageBytes(std::max((int64_t)0, freeSize),
 		                    std::max((int64_t)0, totalSize),
@@ -393,7 +395,22 @@ private:
 	int64_t memoryLimit; // The upper limit on the memory used by the store (excluding, possibly, some clear operations)
 	std::vector<std::pair<KeyValueMapPair, uint64_t>> dataSets;
 
-	int64_t commit_queue(OpQueue& ops, bool log, bool sequential = false) {
+	// Inserts the sets buffered in dataSets, which must be in strictly increasing key order, into data
+	void flushDataSets() {
+		data.insert(dataSets);
+		dataSets.clear();
+	}
+
+	// True if some buffered set in dataSets has a key in [begin, end), where an empty end means the end of the keyspace
+	bool dataSetsOverlap(StringRef begin, Optional<StringRef> end) const {
+		return !dataSets.empty() && begin <= dataSets.back().first.key &&
+		       (!end.present() || dataSets.front().first.key < end.get());
+	}
+
+	// If sortedRuns is set, sets are buffered and inserted in bulk for as long as their keys are strictly increasing,
+	// and only clears which overlap the buffered keys force them into data first.  This is the shape of the snapshot
+	// items replayed by recovery, which would otherwise pay for a full tree search per key.
+	int64_t commit_queue(OpQueue& ops, bool log, bool sequential = false, bool sortedRuns = false) {
 		int64_t total = 0, count = 0;
 		IDiskQueue::location log_location = 0;
 
@@ -401,22 +418,23 @@ private:
 			++count;
 			total += o->p1.size() + o->p2.size() + OP_DISK_OVERHEAD;
 			if (o->op == OpSet) {
-				if (sequential) {
+				if (sequential || sortedRuns) {
+					if (sortedRuns && !dataSets.empty() && o->p1 <= dataSets.back().first.key) {
+						flushDataSets();
+					}
 					KeyValueMapPair pair(o->p1, o->p2);
 					dataSets.push_back(std::make_pair(pair, pair.arena.getSize() + data.getElementBytes()));
 				} else {
 					data.insert(o->p1, o->p2);
 				}
 			} else if (o->op == OpClear) {
-				if (sequential) {
-					data.insert(dataSets);
-					dataSets.clear();
+				if (sequential || dataSetsOverlap(o->p1, o->p2)) {
+					flushDataSets();
 				}
 				data.erase(data.lower_bound(o->p1), data.lower_bound(o->p2));
 			} else if (o->op == OpClearToEnd) {
-				if (sequential) {
-					data.insert(dataSets);
-					dataSets.clear();
+				if (sequential || dataSetsOverlap(o->p1, Optional<StringRef>())) {
+					flushDataSets();
 				}
 				data.erase(data.lower_bound(o->p1), data.end());
 			} else
@@ -424,9 +442,8 @@ private:
 			if (log)
 				log_location = log_op(o->op, o->p1, o->p2);
 		}
-		if (sequential) {
-			data.insert(dataSets);
-			dataSets.clear();
+		if (sequential || sortedRuns) {
+			flushDataSets();
 		}
 
 		bool ok = count < 1e6;
@@ -443,6 +460,19 @@ private:
 		return total;
 	}
 
+	// A snapshot that writes nothing per committed byte would never finish, so the ratio must be positive
+	static double snapshotWriteRatio() {
+		ASSERT(SERVER_KNOBS->KVSTORE_MEMORY_SNAPSHOT_WRITE_RATIO > 0);
+		return SERVER_KNOBS->KVSTORE_MEMORY_SNAPSHOT_WRITE_RATIO;
+	}
+
+	// The log holds up to two snapshots, each interleaved with the writes committed while it was being taken.  The
+	// fewer snapshot bytes written per committed byte, the more of those writes each snapshot spans.
+	static double diskQueueBytesPerDataByte() { return 2 * (1 + 1 / snapshotWriteRatio()); }
+
+	// The amount of committed write budget consumed by writing snapshotBytes of snapshot items
+	static uint64_t snapshotWriteBudget(uint64_t snapshotBytes) { return snapshotBytes / snapshotWriteRatio(); }
+
 	IDiskQueue::location log_op(OpType op, StringRef v1, StringRef v2) {
 		OpHeader h = { (int)op, v1.size(), v2.size() };
 		log->push(StringRef((const uint8_t*)&h, sizeof(h)));
@@ -467,8 +497,12 @@ private:
 			state int dbgSnapshotEndCount = 0;
 			state int dbgMutationCount = 0;
 			state int dbgCommitCount = 0;
+			state int64_t dbgBytesRead = 0;
 			state double startt = now();
 			state UID dbgid = self->id;
+			// RadixTree has no bulk insert
+			state bool bulkRecovery =
+			    SERVER_KNOBS->KVSTORE_MEMORY_BULK_RECOVERY && std::is_same<Container, IKeyValueContainer>::value;
 
 			state Future<Void> loggingDelay = delay(1.0);
 
@@ -476,7 +510,9 @@ private:
 			state OpHeader h;
 			state Standalone<StringRef> lastSnapshotKey;
 
-			TraceEvent("KVSMemRecoveryStarted", self->id).detail("SnapshotEndLocation", uncommittedSnapshotEnd);
+			TraceEvent("KVSMemRecoveryStarted", self->id)
+			    .detail("SnapshotEndLocation", uncommittedSnapshotEnd)
+			    .detail("BulkRecovery", bulkRecovery);
 
 			try {
 				loop {
@@ -500,6 +536,7 @@ private:
 						h = *(OpHeader*)data.begin();
 					}
 					Standalone<StringRef> data = wait(self->log->readNext(h.len1 + h.len2 + 1));
+					dbgBytesRead += sizeof(OpHeader) + data.size();
 					if (data.size() != h.len1 + h.len2 + 1) {
 						zeroFillSize = h.len1 + h.len2 + 1 - data.size();
 						TraceEvent("KVSMemRecoveryComplete", self->id)
@@ -572,7 +609,7 @@ private:
 						} else if (h.op == OpClearToEnd) { // clear all data from begin key to end
 							recoveryQueue.clear_to_end(p1, &data.arena());
 						} else if (h.op == OpCommit) { // commit previous transaction
-							self->commit_queue(recoveryQueue, false);
+							self->commit_queue(recoveryQueue, false, false, bulkRecovery);
 							++dbgCommitCount;
 							self->recoveredSnapshotKey = uncommittedNextKey;
 							self->previousSnapshotEnd = uncommittedPrevSnapshotEnd;
@@ -599,6 +636,8 @@ private:
 						    .detail("SnapshotEnd", dbgSnapshotEndCount)
 						    .detail("Mutations", dbgMutationCount)
 						    .detail("Commits", dbgCommitCount)
+						    .detail("BytesRead", dbgBytesRead)
+						    .detail("BytesPerSecond", dbgBytesRead / (now() - startt))
 						    .detail("EndsAt", self->log->getNextReadLocation());
 						loggingDelay = delay(1.0);
 					}
@@ -629,6 +668,9 @@ private:
 				    .detail("SnapshotEnd", dbgSnapshotEndCount)
 				    .detail("Mutations", dbgMutationCount)
 				    .detail("Commits", dbgCommitCount)
+				    .detail("BytesRead", dbgBytesRead)
+				    .detail("BytesPerSecond", dbgBytesRead / std::max(now() - startt, 1e-6))
+				    .detail("BulkRecovery", bulkRecovery)
 				    .detail("TimeTaken", now() - startt);
 
 				self->semiCommit();
@@ -676,7 +718,7 @@ private:
 
 		state Key nextKey = self->recoveredSnapshotKey;
 		state bool nextKeyAfter = false; // setting this to true is equilvent to setting nextKey = keyAfter(nextKey)
-		state uint64_t snapshotTotalWrittenBytes = 0;
+		state uint64_t snapshotTotalWrittenBytes = 0; // In units of committed write bytes, see snapshotWriteBudget()
 		state int lastDiff = 0;
 		state int snapItems = 0;
 		state uint64_t snapshotBytes = 0;
@@ -744,7 +786,7 @@ private:
 
 					snapItems = 0;
 					snapshotBytes = 0;
-					snapshotTotalWrittenBytes += OP_DISK_OVERHEAD;
+					snapshotTotalWrittenBytes += snapshotWriteBudget(OP_DISK_OVERHEAD);
 
 					// If we're not stopping now, reset next
 					if (snapshotTotalWrittenBytes < self->notifiedCommittedWriteBytes.get()) {
@@ -810,7 +852,7 @@ private:
 					snapItems++;
 					uint64_t opBytes = opKeySize + next.getValue().size() + OP_DISK_OVERHEAD;
 					snapshotBytes += opBytes;
-					snapshotTotalWrittenBytes += opBytes;
+					snapshotTotalWrittenBytes += snapshotWriteBudget(opBytes);
 					lastSnapshotKeyUsingA = !lastSnapshotKeyUsingA;
 
 					// If we're not stopping now, increment next
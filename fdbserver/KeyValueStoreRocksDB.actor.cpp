@@ -1,13 +1,18 @@
 #ifdef SSD_ROCKSDB_EXPERIMENTAL
 
 #include <rocksdb/cache.h>
+#include <rocksdb/convenience.h>
 #include <rocksdb/db.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/options.h>
+#include <rocksdb/rate_limiter.h>
 #include <rocksdb/slice_transform.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/table_properties_collectors.h>
+#include <rocksdb/write_buffer_manager.h>
 #include "flow/flow.h"
+#include "flow/Histogram.h"
 #include "flow/IThreadPool.h"
 
 #endif // SSD_ROCKSDB_EXPERIMENTAL
@@ -39,6 +44,36 @@ rocksdb::ColumnFamilyOptions getCFOptions() {
 	return options;
 }
 
+// The block cache, compaction and flush rate limit and memtable budget sized by ROCKSDB_BLOCK_CACHE_SIZE,
+// ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC and ROCKSDB_WRITE_BUFFER_MANAGER_BYTES.  Each store gets its own, unless
+// ROCKSDB_SHARED_RESOURCES is set, in which case every RocksDB store in the process draws on one set rather than
+// each sizing its own as if it had the machine to itself.  Background threads already come from the default Env.
+struct StoreResources {
+	std::shared_ptr<rocksdb::Cache> blockCache;
+	std::shared_ptr<rocksdb::RateLimiter> rateLimiter;
+	std::shared_ptr<rocksdb::WriteBufferManager> writeBufferManager;
+
+	StoreResources() {
+		if (SERVER_KNOBS->ROCKSDB_BLOCK_CACHE_SIZE > 0) {
+			blockCache = rocksdb::NewLRUCache(SERVER_KNOBS->ROCKSDB_BLOCK_CACHE_SIZE);
+		}
+		if (SERVER_KNOBS->ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC > 0) {
+			rateLimiter.reset(rocksdb::NewGenericRateLimiter(SERVER_KNOBS->ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC));
+		}
+		if (SERVER_KNOBS->ROCKSDB_WRITE_BUFFER_MANAGER_BYTES > 0) {
+			// Memtables are charged against the block cache, if there is one, so the two share one memory limit
+			writeBufferManager = std::make_shared<rocksdb::WriteBufferManager>(
+			    SERVER_KNOBS->ROCKSDB_WRITE_BUFFER_MANAGER_BYTES, blockCache);
+		}
+	}
+
+	// Created by the first store to open, which happens on its writer thread
+	static StoreResources const& shared() {
+		static StoreResources resources;
+		return resources;
+	}
+};
+
 rocksdb::Options getOptions() {
 	rocksdb::Options options({}, getCFOptions());
 	options.avoid_unnecessary_blocking_io = true;
@@ -73,9 +108,10 @@ rocksdb::Options getOptions() {
 		bbOpts.whole_key_filtering = false;
 	}
 
-	if (SERVER_KNOBS->ROCKSDB_BLOCK_CACHE_SIZE > 0) {
-		bbOpts.block_cache = rocksdb::NewLRUCache(SERVER_KNOBS->ROCKSDB_BLOCK_CACHE_SIZE);
-	}
+	StoreResources resources = SERVER_KNOBS->ROCKSDB_SHARED_RESOURCES ? StoreResources::shared() : StoreResources();
+	bbOpts.block_cache = resources.blockCache;
+	options.rate_limiter = resources.rateLimiter;
+	options.write_buffer_manager = resources.writeBufferManager;
 
 	options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(bbOpts));
 	return options;
@@ -92,13 +128,141 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 	using DB = rocksdb::DB*;
 	using CF = rocksdb::ColumnFamilyHandle*;
 
+	// How long each kind of action waited for a thread.  Histograms may only be touched on the network thread, so the
+	// reader and writer threads sample into their own ThreadHistogramSamplers; these references keep the histograms
+	// they feed registered for as long as the store is open.
+	struct ActionMetrics {
+		Reference<Histogram> commitQueueWait, readValueQueueWait, readPrefixQueueWait, readRangeQueueWait,
+		    multiGetQueueWait;
+
+		ActionMetrics()
+		  : commitQueueWait(getQueueWaitHistogram(LiteralStringRef("CommitQueueWait"))),
+		    readValueQueueWait(getQueueWaitHistogram(LiteralStringRef("ReadValueQueueWait"))),
+		    readPrefixQueueWait(getQueueWaitHistogram(LiteralStringRef("ReadPrefixQueueWait"))),
+		    readRangeQueueWait(getQueueWaitHistogram(LiteralStringRef("ReadRangeQueueWait"))),
+		    multiGetQueueWait(getQueueWaitHistogram(LiteralStringRef("MultiGetQueueWait"))) {}
+
+		static Reference<Histogram> getQueueWaitHistogram(StringRef op) {
+			return Histogram::getHistogram(LiteralStringRef("RocksDB"), op, Histogram::Unit::microseconds);
+		}
+
+		// Sampler for use on the thread running the actions whose waits go to the histogram named op
+		static ThreadHistogramSampler queueWaitSampler(const char* op) { return ThreadHistogramSampler("RocksDB", op); }
+
+		// Called on the thread running an action that was created at startTime
+		static void sample(ThreadHistogramSampler& sampler, double startTime) {
+			sampler.sampleSeconds(timer_monotonic() - startTime);
+		}
+	};
+
+	// With ROCKSDB_READ_RANGE_REUSE_ITERATORS, range reads keep their iterators here for the next read in the same
+	// direction with the same bound, for as long as no commit has completed since the iterator was created.  A scan
+	// continuing where the previous read stopped then costs a Seek() rather than building a new merging iterator over
+	// every memtable and level.  An idle iterator pins the memtables and SST files it was created over, so any left
+	// unused for ROCKSDB_READ_RANGE_ITERATOR_IDLE_SECONDS are dropped by releaseIdle().
+	struct CursorCache {
+		struct Cursor {
+			bool forward;
+			Key bound;
+			// iterate_upper_bound (forward) or iterate_lower_bound points here, so it must outlive the iterator
+			rocksdb::Slice boundSlice;
+			uint64_t generation;
+			double lastUsed;
+			std::unique_ptr<rocksdb::Iterator> iterator;
+		};
+
+		ThreadSpinLock lock; // Protects cursors
+		std::vector<std::unique_ptr<Cursor>> cursors;
+
+		// Takes a cursor for a read at the given commit generation out of the cache, or creates one
+		std::unique_ptr<Cursor> checkOut(DB db,
+		                                 rocksdb::ReadOptions options,
+		                                 bool forward,
+		                                 KeyRef bound,
+		                                 uint64_t generation) {
+			std::unique_ptr<Cursor> cursor;
+			std::vector<std::unique_ptr<Cursor>> stale;
+			{
+				ThreadSpinLockHolder holder(lock);
+				for (auto it = cursors.begin(); it != cursors.end();) {
+					if ((*it)->generation != generation) {
+						stale.push_back(std::move(*it));
+						it = cursors.erase(it);
+					} else if (!cursor && (*it)->forward == forward && (*it)->bound == bound) {
+						cursor = std::move(*it);
+						it = cursors.erase(it);
+					} else {
+						++it;
+					}
+				}
+			}
+			if (!cursor) {
+				cursor.reset(new Cursor());
+				cursor->forward = forward;
+				cursor->bound = bound;
+				cursor->boundSlice = toSlice(cursor->bound);
+				cursor->generation = generation;
+				if (forward) {
+					options.iterate_upper_bound = &cursor->boundSlice;
+				} else {
+					options.iterate_lower_bound = &cursor->boundSlice;
+				}
+				cursor->iterator.reset(db->NewIterator(options));
+			}
+			return cursor;
+		}
+
+		// Returns a cursor after a successful read.  At most one cursor per reader thread is kept.
+		void checkIn(std::unique_ptr<Cursor> cursor) {
+			cursor->lastUsed = timer_monotonic();
+			std::unique_ptr<Cursor> evicted;
+			ThreadSpinLockHolder holder(lock);
+			cursors.push_back(std::move(cursor));
+			if (cursors.size() > std::max(SERVER_KNOBS->ROCKSDB_READ_PARALLELISM, 1)) {
+				evicted = std::move(cursors.front());
+				cursors.erase(cursors.begin());
+			}
+		}
+
+		void releaseIdle(double idleSeconds) {
+			std::vector<std::unique_ptr<Cursor>> idle;
+			double now = timer_monotonic();
+			ThreadSpinLockHolder holder(lock);
+			for (auto it = cursors.begin(); it != cursors.end();) {
+				if (now - (*it)->lastUsed >= idleSeconds) {
+					idle.push_back(std::move(*it));
+					it = cursors.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		void clear() {
+			ThreadSpinLockHolder holder(lock);
+			cursors.clear();
+		}
+	};
+
 	struct Writer : IThreadPoolReceiver {
 		DB& db;
 		UID id;
+		ThreadHistogramSampler commitQueueWait;
+		// Bumped after every commit that wrote something, so readers know when a cached iterator is out of date
+		std::atomic<uint64_t>& commitGeneration;
+		std::string path;
+		int64_t bulkFiles = 0;
+
+		// SST files built for bulk loads are written into the database directory under this prefix, which RocksDB
+		// does not recognize as one of its own files
+		static constexpr const char* bulkFilePrefix = "fdb-bulk-";
 
-		explicit Writer(DB& db, UID id) : db(db), id(id) {}
+		Writer(DB& db, UID id, std::atomic<uint64_t>& commitGeneration)
+		  : db(db), id(id), commitQueueWait(ActionMetrics::queueWaitSampler("CommitQueueWait")),
+		    commitGeneration(commitGeneration) {}
 
 		~Writer() override {
+			commitQueueWait.flush();
 			if (db) {
 				delete db;
 			}
@@ -121,6 +285,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			double getTimeEstimate() const override { return SERVER_KNOBS->COMMIT_TIME_ESTIMATE; }
 		};
 		void action(OpenAction& a) {
+			path = a.path;
 			// If the DB has already been initialized, this should be a no-op.
 			if (db != nullptr) {
 				TraceEvent(SevInfo, "RocksDB")
@@ -140,6 +305,12 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 				a.done.sendError(statusToError(status));
 			} else {
 				TraceEvent(SevInfo, "RocksDB").detail("Path", a.path).detail("Method", "Open");
+				// Bulk load files left behind by a crash before they were ingested
+				for (const auto& file : platform::listFiles(a.path, ".sst")) {
+					if (StringRef(file).startsWith(StringRef(bulkFilePrefix))) {
+						deleteFile(joinPath(a.path, file));
+					}
+				}
 				a.done.send(Void());
 			}
 		}
@@ -159,31 +330,154 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			}
 		};
 
-		struct CommitAction : TypedAction<Writer, CommitAction> {
-			std::unique_ptr<rocksdb::WriteBatch> batchToCommit;
-			ThreadReturnPromise<Void> done;
-			double getTimeEstimate() const override { return SERVER_KNOBS->COMMIT_TIME_ESTIMATE; }
-		};
-		void action(CommitAction& a) {
+		// SST files lying entirely inside a range a committed batch cleared hold nothing readable.  For shard-sized
+		// clears, drop those files outright rather than leaving their contents for reads to skip over until compaction
+		// gets to them.  This must only happen once the batch's range tombstone is durable, so that a crash cannot
+		// lose the files' data without also persisting the clear.  The batch's own writes are still in the memtable,
+		// which this leaves alone.
+		void deleteFilesInRange(KeyRangeRef keyRange) {
+			if (SERVER_KNOBS->ROCKSDB_CLEAR_RANGE_DELETE_FILES_BYTES <= 0) {
+				return;
+			}
+			auto begin = toSlice(keyRange.begin);
+			auto end = toSlice(keyRange.end);
+			rocksdb::Range range(begin, end);
+			uint64_t size = 0;
+			rocksdb::SizeApproximationOptions sizeOptions;
+			auto s = db->GetApproximateSizes(sizeOptions, db->DefaultColumnFamily(), &range, 1, &size);
+			if (!s.ok() || size < uint64_t(SERVER_KNOBS->ROCKSDB_CLEAR_RANGE_DELETE_FILES_BYTES)) {
+				return;
+			}
+			double start = timer_monotonic();
+			s = rocksdb::DeleteFilesInRange(db, db->DefaultColumnFamily(), &begin, &end, /*include_end=*/false);
+			if (!s.ok()) {
+				TraceEvent(SevWarn, "RocksDBError", id)
+				    .detail("Error", s.ToString())
+				    .detail("Method", "DeleteFilesInRange");
+				return;
+			}
+			TraceEvent(SevDebug, "RocksDBDeleteFilesInRange", id)
+			    .detail("Begin", keyRange.begin)
+			    .detail("End", keyRange.end)
+			    .detail("ApproximateBytes", size)
+			    .detail("Duration", timer_monotonic() - start);
+		}
+
+		// Writes the blocks, which hold disjoint runs of sorted keys, to a single SST file and ingests it.  Ingestion
+		// assigns the file a sequence number newer than anything already written, so it lands after all prior commits.
+		rocksdb::Status ingestBlocks(std::vector<Standalone<RangeResultRef>>& blocks) {
+			std::sort(blocks.begin(), blocks.end(), [](auto const& a, auto const& b) { return a[0].key < b[0].key; });
+			std::string file = joinPath(path, format("%s%" PRId64 ".sst", bulkFilePrefix, ++bulkFiles));
+			rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), getOptions());
+			auto s = writer.Open(file);
+			for (auto block = blocks.begin(); s.ok() && block != blocks.end(); ++block) {
+				for (auto kv = block->begin(); s.ok() && kv != block->end(); ++kv) {
+					s = writer.Put(toSlice(kv->key), toSlice(kv->value));
+				}
+			}
+			if (s.ok()) {
+				s = writer.Finish();
+			}
+			if (s.ok()) {
+				rocksdb::IngestExternalFileOptions options;
+				// Link the file into the database rather than copying it
+				options.move_files = true;
+				s = db->IngestExternalFile({ file }, options);
+			}
+			if (!s.ok()) {
+				deleteFile(file);
+			}
+			return s;
+		}
+
+		// Loads bulk blocks, falling back to an ordinary write if they could not be ingested (e.g. because the blocks
+		// overlap one another)
+		rocksdb::Status loadBlocks(std::vector<Standalone<RangeResultRef>>& blocks, rocksdb::WriteOptions& options) {
+			double start = timer_monotonic();
+			int64_t bytes = 0;
+			for (const auto& block : blocks) {
+				bytes += block.expectedSize();
+			}
+			auto s = ingestBlocks(blocks);
+			if (s.ok()) {
+				TraceEvent(SevDebug, "RocksDBBulkLoad", id)
+				    .detail("Blocks", blocks.size())
+				    .detail("Bytes", bytes)
+				    .detail("Duration", timer_monotonic() - start);
+				return s;
+			}
+			TraceEvent(SevWarn, "RocksDBBulkLoadFallback", id)
+			    .detail("Error", s.ToString())
+			    .detail("Blocks", blocks.size());
+			rocksdb::WriteBatch batch;
+			for (const auto& block : blocks) {
+				for (const auto& kv : block) {
+					batch.Put(toSlice(kv.key), toSlice(kv.value));
+				}
+			}
+			return db->Write(options, &batch);
+		}
+
+		// Writes a batch, dropping whole SST files for the ranges it clears
+		rocksdb::Status commitBatch(rocksdb::WriteBatch* batch, rocksdb::WriteOptions& options) {
 			Standalone<VectorRef<KeyRangeRef>> deletes;
 			DeleteVisitor dv(deletes, deletes.arena());
-			ASSERT(a.batchToCommit->Iterate(&dv).ok());
+			ASSERT(batch->Iterate(&dv).ok());
 			// If there are any range deletes, we should have added them to be deleted.
-			ASSERT(!deletes.empty() || !a.batchToCommit->HasDeleteRange());
-			rocksdb::WriteOptions options;
-			options.sync = !SERVER_KNOBS->ROCKSDB_UNSAFE_AUTO_FSYNC;
-			auto s = db->Write(options, a.batchToCommit.get());
-			if (!s.ok()) {
-				TraceEvent(SevError, "RocksDBError").detail("Error", s.ToString()).detail("Method", "Commit");
-				a.done.sendError(statusToError(s));
-			} else {
-				a.done.send(Void());
+			ASSERT(!deletes.empty() || !batch->HasDeleteRange());
+			auto s = db->Write(options, batch);
+			if (s.ok()) {
+				++commitGeneration;
 				for (const auto& keyRange : deletes) {
+					deleteFilesInRange(keyRange);
 					auto begin = toSlice(keyRange.begin);
 					auto end = toSlice(keyRange.end);
 					ASSERT(db->SuggestCompactRange(db->DefaultColumnFamily(), &begin, &end).ok());
 				}
 			}
+			return s;
+		}
+
+		// Part of a commit: a batch of mutations followed by the bulk blocks set after them, before any later mutation
+		struct CommitPart {
+			std::unique_ptr<rocksdb::WriteBatch> batch;
+			std::vector<Standalone<RangeResultRef>> bulkBlocks;
+		};
+
+		struct CommitAction : TypedAction<Writer, CommitAction> {
+			std::vector<CommitPart> parts;
+			ThreadReturnPromise<Void> done;
+			double startTime = timer_monotonic();
+			double getTimeEstimate() const override { return SERVER_KNOBS->COMMIT_TIME_ESTIMATE; }
+		};
+		void action(CommitAction& a) {
+			ActionMetrics::sample(commitQueueWait, a.startTime);
+			rocksdb::WriteOptions options;
+			options.sync = !SERVER_KNOBS->ROCKSDB_UNSAFE_AUTO_FSYNC;
+			// Parts are applied in the order they were issued, so a clear before setBulk() leaves the loaded data and
+			// one after it removes it.  They are not applied atomically: if one fails, the storage server recovers
+			// from its last durable version, redoing the commit's sets and clears and discarding any fetched range it
+			// had not yet made available.
+			for (auto& part : a.parts) {
+				if (part.batch) {
+					auto s = commitBatch(part.batch.get(), options);
+					if (!s.ok()) {
+						TraceEvent(SevError, "RocksDBError").detail("Error", s.ToString()).detail("Method", "Commit");
+						a.done.sendError(statusToError(s));
+						return;
+					}
+				}
+				if (!part.bulkBlocks.empty()) {
+					auto s = loadBlocks(part.bulkBlocks, options);
+					if (!s.ok()) {
+						TraceEvent(SevError, "RocksDBError").detail("Error", s.ToString()).detail("Method", "BulkLoad");
+						a.done.sendError(statusToError(s));
+						return;
+					}
+					++commitGeneration;
+				}
+			}
+			a.done.send(Void());
 		}
 
 		struct CloseAction : TypedAction<Writer, CloseAction> {
@@ -219,19 +513,44 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 	struct Reader : IThreadPoolReceiver {
 		DB& db;
-
-		explicit Reader(DB& db) : db(db) {}
+		std::atomic<uint64_t> const& commitGeneration;
+		CursorCache& cursors;
+		ThreadHistogramSampler readValueQueueWait, readPrefixQueueWait, readRangeQueueWait, multiGetQueueWait;
+
+		Reader(DB& db, std::atomic<uint64_t> const& commitGeneration, CursorCache& cursors)
+		  : db(db), commitGeneration(commitGeneration), cursors(cursors),
+		    readValueQueueWait(ActionMetrics::queueWaitSampler("ReadValueQueueWait")),
+		    readPrefixQueueWait(ActionMetrics::queueWaitSampler("ReadPrefixQueueWait")),
+		    readRangeQueueWait(ActionMetrics::queueWaitSampler("ReadRangeQueueWait")),
+		    multiGetQueueWait(ActionMetrics::queueWaitSampler("MultiGetQueueWait")) {}
+
+		~Reader() override {
+			readValueQueueWait.flush();
+			readPrefixQueueWait.flush();
+			readRangeQueueWait.flush();
+			multiGetQueueWait.flush();
+		}
 
 		void init() override {}
 
+		struct ReleaseIdleCursorsAction : TypedAction<Reader, ReleaseIdleCursorsAction> {
+			double getTimeEstimate() const override { return 0; }
+			ThreadActionLane getLane() const override { return ThreadActionLane::Low; }
+		};
+		void action(ReleaseIdleCursorsAction& a) {
+			cursors.releaseIdle(SERVER_KNOBS->ROCKSDB_READ_RANGE_ITERATOR_IDLE_SECONDS);
+		}
+
 		struct ReadValueAction : TypedAction<Reader, ReadValueAction> {
 			Key key;
 			Optional<UID> debugID;
 			ThreadReturnPromise<Optional<Value>> result;
+			double startTime = timer_monotonic();
 			ReadValueAction(KeyRef key, Optional<UID> debugID) : key(key), debugID(debugID) {}
 			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE; }
 		};
 		void action(ReadValueAction& a) {
+			ActionMetrics::sample(readValueQueueWait, a.startTime);
 			Optional<TraceBatch> traceBatch;
 			if (a.debugID.present()) {
 				traceBatch = { TraceBatch{} };
@@ -258,11 +577,13 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			int maxLength;
 			Optional<UID> debugID;
 			ThreadReturnPromise<Optional<Value>> result;
+			double startTime = timer_monotonic();
 			ReadValuePrefixAction(Key key, int maxLength, Optional<UID> debugID)
 			  : key(key), maxLength(maxLength), debugID(debugID){};
 			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE; }
 		};
 		void action(ReadValuePrefixAction& a) {
+			ActionMetrics::sample(readPrefixQueueWait, a.startTime);
 			rocksdb::PinnableSlice value;
 			Optional<TraceBatch> traceBatch;
 			if (a.debugID.present()) {
@@ -287,18 +608,60 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			}
 		}
 
+		// Point reads gathered over one run loop iteration by RocksDBKeyValueStore::readValue()
+		struct MultiGetAction : TypedAction<Reader, MultiGetAction> {
+			std::vector<Key> keys;
+			std::deque<ThreadReturnPromise<Optional<Value>>> results;
+			double startTime = timer_monotonic();
+
+			Future<Optional<Value>> add(KeyRef key) {
+				keys.push_back(key);
+				results.emplace_back();
+				return results.back().getFuture();
+			}
+			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE * keys.size(); }
+		};
+		void action(MultiGetAction& a) {
+			ActionMetrics::sample(multiGetQueueWait, a.startTime);
+			std::vector<rocksdb::Slice> keys;
+			keys.reserve(a.keys.size());
+			for (const auto& key : a.keys) {
+				keys.push_back(toSlice(key));
+			}
+			std::vector<rocksdb::PinnableSlice> values(keys.size());
+			std::vector<rocksdb::Status> statuses(keys.size());
+			db->MultiGet(
+			    getReadOptions(), db->DefaultColumnFamily(), keys.size(), keys.data(), values.data(), statuses.data());
+			for (size_t i = 0; i < keys.size(); ++i) {
+				if (statuses[i].ok()) {
+					a.results[i].send(Value(toStringRef(values[i])));
+				} else {
+					if (!statuses[i].IsNotFound()) {
+						TraceEvent(SevError, "RocksDBError")
+						    .detail("Error", statuses[i].ToString())
+						    .detail("Method", "MultiGet");
+					}
+					a.results[i].send(Optional<Value>());
+				}
+			}
+		}
+
 		struct ReadRangeAction : TypedAction<Reader, ReadRangeAction>, FastAllocated<ReadRangeAction> {
 			KeyRange keys;
 			int rowLimit, byteLimit;
 			ThreadReturnPromise<Standalone<RangeResultRef>> result;
+			double startTime = timer_monotonic();
 			ReadRangeAction(KeyRange keys, int rowLimit, int byteLimit)
 			  : keys(keys), rowLimit(rowLimit), byteLimit(byteLimit) {}
 			double getTimeEstimate() const override { return SERVER_KNOBS->READ_RANGE_TIME_ESTIMATE; }
+			ThreadActionLane getLane() const override { return ThreadActionLane::Low; }
 		};
 		void action(ReadRangeAction& a) {
+			ActionMetrics::sample(readRangeQueueWait, a.startTime);
 			Standalone<RangeResultRef> result;
 			if (a.rowLimit == 0 || a.byteLimit == 0) {
 				a.result.send(result);
+				return;
 			}
 			int accumulatedBytes = 0;
 			rocksdb::Status s;
@@ -306,10 +669,29 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			// When using a prefix extractor, ensure that keys are returned in order even if they cross
 			// a prefix boundary.
 			options.auto_prefix_mode = (SERVER_KNOBS->ROCKSDB_PREFIX_LEN > 0);
+			auto beginSlice = toSlice(a.keys.begin);
+			auto endSlice = toSlice(a.keys.end);
+			std::unique_ptr<rocksdb::Iterator> ownedCursor;
+			std::unique_ptr<CursorCache::Cursor> cachedCursor;
+			rocksdb::Iterator* cursor;
+			bool reuse = SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_ITERATORS;
+			if (reuse) {
+				// A read posted after a commit completed is ordered after the increment of commitGeneration, so it
+				// never reuses an iterator that misses that commit.
+				bool forward = a.rowLimit >= 0;
+				cachedCursor = cursors.checkOut(
+				    db, options, forward, forward ? a.keys.end : a.keys.begin, commitGeneration.load());
+				cursor = cachedCursor->iterator.get();
+			} else {
+				if (a.rowLimit >= 0) {
+					options.iterate_upper_bound = &endSlice;
+				} else {
+					options.iterate_lower_bound = &beginSlice;
+				}
+				ownedCursor.reset(db->NewIterator(options));
+				cursor = ownedCursor.get();
+			}
 			if (a.rowLimit >= 0) {
-				auto endSlice = toSlice(a.keys.end);
-				options.iterate_upper_bound = &endSlice;
-				auto cursor = std::unique_ptr<rocksdb::Iterator>(db->NewIterator(options));
 				cursor->Seek(toSlice(a.keys.begin));
 				while (cursor->Valid() && toStringRef(cursor->key()) < a.keys.end) {
 					KeyValueRef kv(toStringRef(cursor->key()), toStringRef(cursor->value()));
@@ -323,9 +705,6 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 				}
 				s = cursor->status();
 			} else {
-				auto beginSlice = toSlice(a.keys.begin);
-				options.iterate_lower_bound = &beginSlice;
-				auto cursor = std::unique_ptr<rocksdb::Iterator>(db->NewIterator(options));
 				cursor->SeekForPrev(toSlice(a.keys.end));
 				if (cursor->Valid() && toStringRef(cursor->key()) == a.keys.end) {
 					cursor->Prev();
@@ -345,6 +724,8 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 			if (!s.ok()) {
 				TraceEvent(SevError, "RocksDBError").detail("Error", s.ToString()).detail("Method", "ReadRange");
+			} else if (reuse) {
+				cursors.checkIn(std::move(cachedCursor));
 			}
 			result.more =
 			    (result.size() == a.rowLimit) || (result.size() == -a.rowLimit) || (accumulatedBytes >= a.byteLimit);
@@ -363,20 +744,47 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 	Promise<Void> errorPromise;
 	Promise<Void> closePromise;
 	std::unique_ptr<rocksdb::WriteBatch> writeBatch;
+	// The parts of the next commit before writeBatch
+	std::vector<Writer::CommitPart> commitParts;
+	ActionMetrics metrics;
+	std::atomic<uint64_t> commitGeneration{ 0 };
+	CursorCache cursors;
+	std::unique_ptr<Reader::MultiGetAction> pendingGets;
+	Future<Void> postingGets;
+	Future<Void> metricsLogger;
+	Future<Void> cursorReleaser;
 
 	explicit RocksDBKeyValueStore(const std::string& path, UID id) : path(path), id(id) {
 		writeThread = createGenericThreadPool();
-		readThreads = createGenericThreadPool();
-		writeThread->addThread(new Writer(db, id), "fdb-rocksdb-wr");
+		if (SERVER_KNOBS->ROCKSDB_READ_WORK_STEALING) {
+			// Keeps point reads from queueing behind long range reads on a busy reader thread
+			std::vector<int> cpus;
+			StringRef cpuList(SERVER_KNOBS->ROCKSDB_READ_THREAD_CPUS);
+			while (!cpuList.empty()) {
+				cpus.push_back(atoi(cpuList.eat(",").toString().c_str()));
+			}
+			readThreads = createWorkStealingThreadPool("RocksDBReadThreads", 0, cpus);
+		} else {
+			readThreads = createGenericThreadPool();
+		}
+		writeThread->addThread(new Writer(db, id, commitGeneration), "fdb-rocksdb-wr");
 		for (unsigned i = 0; i < SERVER_KNOBS->ROCKSDB_READ_PARALLELISM; ++i) {
-			readThreads->addThread(new Reader(db), "fdb-rocksdb-re");
+			readThreads->addThread(new Reader(db, commitGeneration, cursors), "fdb-rocksdb-re");
 		}
 	}
 
 	Future<Void> getError() override { return errorPromise.getFuture(); }
 
 	ACTOR static void doClose(RocksDBKeyValueStore* self, bool deleteOnClose) {
+		self->metricsLogger.cancel();
+		self->cursorReleaser.cancel();
+		self->postingGets.cancel();
+		if (self->pendingGets) {
+			self->readThreads->post(self->pendingGets.release());
+		}
 		wait(self->readThreads->stop());
+		// Cached iterators must go before the writer thread closes the database
+		self->cursors.clear();
 		auto a = new Writer::CloseAction(self->path, deleteOnClose);
 		auto f = a->done.getFuture();
 		self->writeThread->post(a);
@@ -397,11 +805,56 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 	KeyValueStoreType getType() const override { return KeyValueStoreType(KeyValueStoreType::SSD_ROCKSDB_V1); }
 
+	ACTOR static Future<Void> logMetrics(RocksDBKeyValueStore* self, Future<Void> opened) {
+		wait(opened);
+		state std::vector<std::pair<const char*, std::string>> properties = {
+			{ "BlockCacheUsage", rocksdb::DB::Properties::kBlockCacheUsage },
+			{ "BlockCachePinnedUsage", rocksdb::DB::Properties::kBlockCachePinnedUsage },
+			{ "BlockCacheCapacity", rocksdb::DB::Properties::kBlockCacheCapacity },
+			{ "MemtableBytes", rocksdb::DB::Properties::kCurSizeAllMemTables },
+			{ "EstimatedPendingCompactionBytes", rocksdb::DB::Properties::kEstimatePendingCompactionBytes },
+			{ "RunningCompactions", rocksdb::DB::Properties::kNumRunningCompactions },
+		};
+		loop {
+			wait(delay(SERVER_KNOBS->ROCKSDB_METRICS_DELAY));
+			TraceEvent e("RocksDBMetrics", self->id);
+			for (const auto& [name, property] : properties) {
+				uint64_t value = 0;
+				self->db->GetIntProperty(property, &value);
+				e.detail(name, value);
+			}
+			e.detail("SharedResources", SERVER_KNOBS->ROCKSDB_SHARED_RESOURCES);
+			// The store's own limiter and budget, or the process-wide ones with ROCKSDB_SHARED_RESOURCES
+			rocksdb::DBOptions options = self->db->GetDBOptions();
+			if (options.rate_limiter) {
+				e.detail("RateLimiterBytesPerSec", options.rate_limiter->GetBytesPerSecond())
+				    .detail("RateLimiterTotalBytes", options.rate_limiter->GetTotalBytesThrough());
+			}
+			if (options.write_buffer_manager) {
+				e.detail("WriteBufferManagerUsage", options.write_buffer_manager->memory_usage())
+				    .detail("WriteBufferManagerLimit", options.write_buffer_manager->buffer_size());
+			}
+		}
+	}
+
+	ACTOR static Future<Void> releaseIdleCursors(RocksDBKeyValueStore* self) {
+		loop {
+			wait(delay(SERVER_KNOBS->ROCKSDB_READ_RANGE_ITERATOR_IDLE_SECONDS));
+			self->readThreads->post(new Reader::ReleaseIdleCursorsAction());
+		}
+	}
+
 	Future<Void> init() override {
 		std::unique_ptr<Writer::OpenAction> a(new Writer::OpenAction());
 		a->path = path;
 		auto res = a->done.getFuture();
 		writeThread->post(a.release());
+		if (!metricsLogger.isValid()) {
+			metricsLogger = logMetrics(this, res);
+		}
+		if (SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_ITERATORS && !cursorReleaser.isValid()) {
+			cursorReleaser = releaseIdleCursors(this);
+		}
 		return res;
 	}
 
@@ -420,19 +873,53 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		writeBatch->DeleteRange(toSlice(keyRange.begin), toSlice(keyRange.end));
 	}
 
+	void setBulk(Standalone<RangeResultRef> const& block) override {
+		if (block.empty()) {
+			return;
+		}
+		// Mutations issued so far are written before the block, consecutive blocks are loaded together
+		if (writeBatch != nullptr || commitParts.empty()) {
+			commitParts.emplace_back();
+			commitParts.back().batch = std::move(writeBatch);
+		}
+		commitParts.back().bulkBlocks.push_back(block);
+	}
+
+	bool supportsBulkLoad() const override { return true; }
+
 	Future<Void> commit(bool) override {
 		// If there is nothing to write, don't write.
-		if (writeBatch == nullptr) {
+		if (writeBatch == nullptr && commitParts.empty()) {
 			return Void();
 		}
+		if (writeBatch != nullptr) {
+			commitParts.emplace_back();
+			commitParts.back().batch = std::move(writeBatch);
+		}
 		auto a = new Writer::CommitAction();
-		a->batchToCommit = std::move(writeBatch);
+		a->parts = std::move(commitParts);
+		commitParts.clear();
 		auto res = a->done.getFuture();
 		writeThread->post(a);
 		return res;
 	}
 
+	ACTOR static Future<Void> postGets(RocksDBKeyValueStore* self) {
+		// Let the rest of this run loop iteration add its point reads to the batch
+		wait(delay(0));
+		self->readThreads->post(self->pendingGets.release());
+		return Void();
+	}
+
 	Future<Optional<Value>> readValue(KeyRef key, Optional<UID> debugID) override {
+		// Reads being traced keep their own action so that their trace events still bracket just that read
+		if (SERVER_KNOBS->ROCKSDB_READ_VALUE_BATCHING && !debugID.present()) {
+			if (!pendingGets) {
+				pendingGets.reset(new Reader::MultiGetAction());
+				postingGets = postGets(this);
+			}
+			return pendingGets->add(key);
+		}
 		auto a = new Reader::ReadValueAction(key, debugID);
 		auto res = a->result.getFuture();
 		readThreads->post(a);
@@ -521,6 +1008,135 @@ TEST_CASE("fdbserver/KeyValueStoreRocksDB/Reopen") {
 	return Void();
 }
 
+TEST_CASE("fdbserver/KeyValueStoreRocksDB/ClearRange") {
+	state const std::string rocksDBTestDir = "rocksdb-kvstore-clearrange-test-db";
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+
+	state IKeyValueStore* kvStore = new RocksDBKeyValueStore(rocksDBTestDir, deterministicRandom()->randomUniqueID());
+	wait(kvStore->init());
+
+	for (int i = 0; i < 1000; ++i) {
+		kvStore->set({ StringRef(format("key%04d", i)), LiteralStringRef("value") });
+	}
+	wait(kvStore->commit(false));
+
+	// Leaves keys on either side of the cleared range
+	kvStore->clear(KeyRangeRef(LiteralStringRef("key0100"), LiteralStringRef("key0900")));
+	wait(kvStore->commit(false));
+
+	Standalone<RangeResultRef> cleared =
+	    wait(kvStore->readRange(KeyRangeRef(LiteralStringRef("key0100"), LiteralStringRef("key0900"))));
+	ASSERT(cleared.empty());
+	Standalone<RangeResultRef> remaining =
+	    wait(kvStore->readRange(KeyRangeRef(LiteralStringRef("key"), LiteralStringRef("kez"))));
+	ASSERT(remaining.size() == 200);
+
+	Future<Void> closed = kvStore->onClosed();
+	kvStore->dispose();
+	wait(closed);
+
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+	return Void();
+}
+
+// Number of live SST files holding only keys in [begin, end)
+int liveFilesWithin(rocksdb::DB* db, std::string const& begin, std::string const& end) {
+	std::vector<rocksdb::LiveFileMetaData> files;
+	db->GetLiveFilesMetaData(&files);
+	return std::count_if(files.begin(), files.end(), [&](auto const& f) {
+		return f.smallestkey >= begin && f.largestkey < end;
+	});
+}
+
+TEST_CASE("fdbserver/KeyValueStoreRocksDB/ClearRangeDeleteFiles") {
+	state const std::string rocksDBTestDir = "rocksdb-kvstore-clearrange-deletefiles-test-db";
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+	state std::string deleteFilesBytes = std::to_string(SERVER_KNOBS->ROCKSDB_CLEAR_RANGE_DELETE_FILES_BYTES);
+	ASSERT(const_cast<ServerKnobs*>(SERVER_KNOBS)->setKnob("rocksdb_clear_range_delete_files_bytes", "1"));
+
+	state RocksDBKeyValueStore* kvStore =
+	    new RocksDBKeyValueStore(rocksDBTestDir, deterministicRandom()->randomUniqueID());
+	wait(kvStore->init());
+
+	// Each commit's bulk loaded blocks are ingested as one SST file
+	state Standalone<RangeResultRef> low, high;
+	for (int i = 0; i < 100; ++i) {
+		low.push_back_deep(low.arena(), KeyValueRef(StringRef(format("key%04d", i)), LiteralStringRef("low")));
+		high.push_back_deep(high.arena(), KeyValueRef(StringRef(format("key%04d", i + 100)), LiteralStringRef("high")));
+	}
+	kvStore->setBulk(low);
+	wait(kvStore->commit(false));
+	kvStore->setBulk(high);
+	wait(kvStore->commit(false));
+	ASSERT(liveFilesWithin(kvStore->db, "key", "key0100") == 1);
+
+	// The file holding the cleared range is dropped, and a write after the clear in the same commit survives
+	kvStore->clear(KeyRangeRef(LiteralStringRef("key"), LiteralStringRef("key0100")));
+	kvStore->set({ LiteralStringRef("key0050"), LiteralStringRef("new") });
+	wait(kvStore->commit(false));
+	ASSERT(liveFilesWithin(kvStore->db, "key", "key0100") == 0);
+	ASSERT(liveFilesWithin(kvStore->db, "key0100", "kez") == 1);
+
+	Standalone<RangeResultRef> remaining =
+	    wait(kvStore->readRange(KeyRangeRef(LiteralStringRef("key"), LiteralStringRef("kez"))));
+	ASSERT(remaining.size() == 101);
+	ASSERT(remaining[0].key == LiteralStringRef("key0050") && remaining[0].value == LiteralStringRef("new"));
+	ASSERT(remaining[1].key == LiteralStringRef("key0100") && remaining[1].value == LiteralStringRef("high"));
+
+	Future<Void> closed = kvStore->onClosed();
+	kvStore->dispose();
+	wait(closed);
+
+	ASSERT(const_cast<ServerKnobs*>(SERVER_KNOBS)->setKnob("rocksdb_clear_range_delete_files_bytes", deleteFilesBytes));
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+	return Void();
+}
+
+TEST_CASE("fdbserver/KeyValueStoreRocksDB/BulkLoad") {
+	state const std::string rocksDBTestDir = "rocksdb-kvstore-bulkload-test-db";
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+
+	state IKeyValueStore* kvStore = new RocksDBKeyValueStore(rocksDBTestDir, deterministicRandom()->randomUniqueID());
+	wait(kvStore->init());
+	ASSERT(kvStore->supportsBulkLoad());
+
+	// Two disjoint blocks, handed over out of order
+	state Standalone<RangeResultRef> high, low;
+	for (int i = 0; i < 100; ++i) {
+		low.push_back_deep(low.arena(), KeyValueRef(StringRef(format("key%04d", i)), LiteralStringRef("low")));
+		high.push_back_deep(high.arena(), KeyValueRef(StringRef(format("key%04d", i + 100)), LiteralStringRef("high")));
+	}
+	kvStore->setBulk(high);
+	kvStore->setBulk(low);
+	// A clear later in the same commit applies to the bulk loaded data
+	kvStore->clear(KeyRangeRef(LiteralStringRef("key0050"), LiteralStringRef("key0150")));
+	wait(kvStore->commit(false));
+
+	Standalone<RangeResultRef> remaining =
+	    wait(kvStore->readRange(KeyRangeRef(LiteralStringRef("key"), LiteralStringRef("kez"))));
+	ASSERT(remaining.size() == 100);
+	ASSERT(remaining[0].value == LiteralStringRef("low"));
+	ASSERT(remaining[99].value == LiteralStringRef("high"));
+
+	// A clear earlier in the same commit does not apply to the bulk loaded data
+	kvStore->clear(KeyRangeRef(LiteralStringRef("key"), LiteralStringRef("kez")));
+	kvStore->setBulk(low);
+	wait(kvStore->commit(false));
+
+	Standalone<RangeResultRef> reloaded =
+	    wait(kvStore->readRange(KeyRangeRef(LiteralStringRef("key"), LiteralStringRef("kez"))));
+	ASSERT(reloaded.size() == 100);
+	ASSERT(reloaded[0].key == LiteralStringRef("key0000") && reloaded[0].value == LiteralStringRef("low"));
+	ASSERT(reloaded[99].key == LiteralStringRef("key0099") && reloaded[99].value == LiteralStringRef("low"));
+
+	Future<Void> closed = kvStore->onClosed();
+	kvStore->dispose();
+	wait(closed);
+
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+	return Void();
+}
+
 } // namespace
 
 #endif // SSD_ROCKSDB_EXPERIMENTAL
@@ -60,10 +60,11 @@ struct SpringCleaningStats {
 	double springCleaningTime;
 	double vacuumTime;
 	double lazyDeleteTime;
+	double budgetScale; // of the most recent spring cleaning
 
 	SpringCleaningStats()
 	  : springCleaningCount(0), lazyDeletePages(0), vacuumedPages(0), springCleaningTime(0.0), vacuumTime(0.0),
-	    lazyDeleteTime(0.0) {}
+	    lazyDeleteTime(0.0), budgetScale(1.0) {}
 };
 
 struct PageChecksumCodec {
@@ -1595,7 +1596,9 @@ public:
 		int vacuumedPages = 0;
 	};
 
-	Future<SpringCleaningWorkPerformed> doClean();
+	// budgetScale multiplies the time and vacuum batch size of one round of spring cleaning
+	Future<SpringCleaningWorkPerformed> doClean(double budgetScale = 1.0);
+	double springCleaningBudgetScale() const;
 	void startReadThreads();
 
 private:
@@ -1606,7 +1609,8 @@ private:
 	Promise<Void> stopped;
 	Future<Void> cleaning, logging, starting, stopOnErr;
 
-	int64_t readsRequested, writesRequested;
+	int64_t readsRequested;
+	volatile int64_t writesRequested;
 	ThreadSafeCounter readsComplete;
 	volatile int64_t writesComplete;
 	volatile SpringCleaningStats springCleaningStats;
@@ -1715,6 +1719,7 @@ private:
 		int commits;
 		int setsThisCommit;
 		bool freeTableEmpty; // true if we are sure the freetable (pages pending lazy deletion) is empty
+		volatile int64_t& writesRequested;
 		volatile int64_t& writesComplete;
 		volatile SpringCleaningStats& springCleaningStats;
 		volatile int64_t& diskBytesUsed;
@@ -1728,6 +1733,7 @@ private:
 		                bool isBtreeV2,
 		                bool checkAllChecksumsOnOpen,
 		                bool checkIntegrityOnOpen,
+		                volatile int64_t& writesRequested,
 		                volatile int64_t& writesComplete,
 		                volatile SpringCleaningStats& springCleaningStats,
 		                volatile int64_t& diskBytesUsed,
@@ -1735,7 +1741,8 @@ private:
 		                UID dbgid,
 		                vector<Reference<ReadCursor>>* pReadThreads)
 		  : kvs(kvs), conn(kvs->filename, isBtreeV2, isBtreeV2), commits(), setsThisCommit(), freeTableEmpty(false),
-		    writesComplete(writesComplete), springCleaningStats(springCleaningStats), diskBytesUsed(diskBytesUsed),
+		    writesRequested(writesRequested), writesComplete(writesComplete), springCleaningStats(springCleaningStats),
+		    diskBytesUsed(diskBytesUsed),
 		    freeListPages(freeListPages), cursor(nullptr), dbgid(dbgid), readThreads(*pReadThreads),
 		    checkAllChecksumsOnOpen(checkAllChecksumsOnOpen), checkIntegrityOnOpen(checkIntegrityOnOpen) {}
 		~Writer() override {
@@ -1891,15 +1898,31 @@ private:
 
 		struct SpringCleaningAction : TypedAction<Writer, SpringCleaningAction>, FastAllocated<SpringCleaningAction> {
 			ThreadReturnPromise<SpringCleaningWorkPerformed> result;
+			double budgetScale;
+			explicit SpringCleaningAction(double budgetScale) : budgetScale(budgetScale) {}
 			double getTimeEstimate() const override {
-				return std::max(SERVER_KNOBS->SPRING_CLEANING_LAZY_DELETE_TIME_ESTIMATE,
-				                SERVER_KNOBS->SPRING_CLEANING_VACUUM_TIME_ESTIMATE);
+				return budgetScale * std::max(SERVER_KNOBS->SPRING_CLEANING_LAZY_DELETE_TIME_ESTIMATE,
+				                              SERVER_KNOBS->SPRING_CLEANING_VACUUM_TIME_ESTIMATE);
 			}
 		};
 		void action(SpringCleaningAction& a) {
 			double s = now();
-			double lazyDeleteEnd = now() + SERVER_KNOBS->SPRING_CLEANING_LAZY_DELETE_TIME_ESTIMATE;
-			double vacuumEnd = now() + SERVER_KNOBS->SPRING_CLEANING_VACUUM_TIME_ESTIMATE;
+			double budgetScale = a.budgetScale;
+			double lazyDeleteEnd = now() + SERVER_KNOBS->SPRING_CLEANING_LAZY_DELETE_TIME_ESTIMATE * budgetScale;
+			double vacuumEnd = now() + SERVER_KNOBS->SPRING_CLEANING_VACUUM_TIME_ESTIMATE * budgetScale;
+			// Each incremental vacuum step moves one page from the end of the file; taking them in batches between
+			// yields lets a large backlog shrink the file a run of pages at a time
+			int vacuumBatchSize = std::max(1, (int)(SERVER_KNOBS->SPRING_CLEANING_VACUUM_BATCH_SIZE * budgetScale));
+			// A scaled up budget is only for idle time, so it drops back to the base budget as soon as a commit or
+			// any other write is queued behind this action
+			auto checkWriteQueued = [&]() {
+				if (budgetScale > 1.0 && writesRequested != writesComplete + 1) {
+					budgetScale = 1.0;
+					lazyDeleteEnd = std::min(lazyDeleteEnd, s + SERVER_KNOBS->SPRING_CLEANING_LAZY_DELETE_TIME_ESTIMATE);
+					vacuumEnd = std::min(vacuumEnd, s + SERVER_KNOBS->SPRING_CLEANING_VACUUM_TIME_ESTIMATE);
+					vacuumBatchSize = std::max(1, SERVER_KNOBS->SPRING_CLEANING_VACUUM_BATCH_SIZE);
+				}
+			};
 
 			SpringCleaningWorkPerformed workPerformed;
 
@@ -1912,6 +1935,7 @@ private:
 			bool vacuumFinished = false;
 
 			loop {
+				checkWriteQueued();
 				double begin = now();
 				bool canDelete = !freeTableEmpty &&
 				                 (now() < lazyDeleteEnd || workPerformed.lazyDeletePages <
@@ -1946,9 +1970,14 @@ private:
 					TEST(SERVER_KNOBS->SPRING_CLEANING_VACUUMS_PER_LAZY_DELETE_PAGE !=
 					     0); // SQLite vacuuming with nonzero vacuums_per_lazy_delete_page
 
-					vacuumFinished = conn.vacuum();
-					if (!vacuumFinished) {
-						++workPerformed.vacuumedPages;
+					for (int i = 0; i < vacuumBatchSize && !vacuumFinished &&
+					                workPerformed.vacuumedPages < SERVER_KNOBS->SPRING_CLEANING_MAX_VACUUM_PAGES;
+					     ++i) {
+						checkWriteQueued();
+						vacuumFinished = conn.vacuum();
+						if (!vacuumFinished) {
+							++workPerformed.vacuumedPages;
+						}
 					}
 
 					vacuumTime += now() - begin;
@@ -1970,6 +1999,7 @@ private:
 			springCleaningStats.springCleaningTime += now() - s;
 			springCleaningStats.vacuumTime += vacuumTime;
 			springCleaningStats.lazyDeleteTime += lazyDeleteTime;
+			springCleaningStats.budgetScale = budgetScale;
 
 			a.result.send(workPerformed);
 			++writesComplete;
@@ -1998,7 +2028,10 @@ private:
 			    .detail("VacuumedPages", self->springCleaningStats.vacuumedPages)
 			    .detail("SpringCleaningTime", self->springCleaningStats.springCleaningTime)
 			    .detail("LazyDeleteTime", self->springCleaningStats.lazyDeleteTime)
-			    .detail("VacuumTime", self->springCleaningStats.vacuumTime);
+			    .detail("VacuumTime", self->springCleaningStats.vacuumTime)
+			    .detail("BudgetScale", self->springCleaningStats.budgetScale)
+			    .detail("FreeListPages", self->freeListPages)
+			    .detail("ReclaimableBytes", self->freeListPages * _PAGE_SIZE);
 
 			lastReadsComplete = self->readsComplete;
 			lastWritesComplete = self->writesComplete;
@@ -2080,7 +2113,8 @@ IKeyValueStore* keyValueStoreSQLite(std::string const& filename,
 ACTOR Future<Void> cleanPeriodically(KeyValueStoreSQLite* self) {
 	wait(delayJittered(SERVER_KNOBS->SPRING_CLEANING_NO_ACTION_INTERVAL));
 	loop {
-		KeyValueStoreSQLite::SpringCleaningWorkPerformed workPerformed = wait(self->doClean());
+		state double budgetScale = self->springCleaningBudgetScale();
+		KeyValueStoreSQLite::SpringCleaningWorkPerformed workPerformed = wait(self->doClean(budgetScale));
 
 		double duration = std::numeric_limits<double>::max();
 		if (workPerformed.lazyDeletePages >= SERVER_KNOBS->SPRING_CLEANING_LAZY_DELETE_BATCH_SIZE) {
@@ -2091,6 +2125,8 @@ ACTOR Future<Void> cleanPeriodically(KeyValueStoreSQLite* self) {
 		}
 		if (duration == std::numeric_limits<double>::max()) {
 			duration = SERVER_KNOBS->SPRING_CLEANING_NO_ACTION_INTERVAL;
+		} else {
+			duration /= budgetScale;
 		}
 
 		wait(delayJittered(duration));
@@ -2140,6 +2176,7 @@ KeyValueStoreSQLite::KeyValueStoreSQLite(std::string const& filename,
 	                                  type == KeyValueStoreType::SSD_BTREE_V2,
 	                                  checkChecksums,
 	                                  checkIntegrity,
+	                                  writesRequested,
 	                                  writesComplete,
 	                                  springCleaningStats,
 	                                  diskBytesUsed,
@@ -2214,14 +2251,25 @@ Future<Standalone<RangeResultRef>> KeyValueStoreSQLite::readRange(KeyRangeRef ke
 	readThreads->post(p);
 	return f;
 }
-Future<KeyValueStoreSQLite::SpringCleaningWorkPerformed> KeyValueStoreSQLite::doClean() {
+Future<KeyValueStoreSQLite::SpringCleaningWorkPerformed> KeyValueStoreSQLite::doClean(double budgetScale) {
 	++writesRequested;
-	auto p = new Writer::SpringCleaningAction;
+	auto p = new Writer::SpringCleaningAction(budgetScale);
 	auto f = p->result.getFuture();
 	writeThread->post(p);
 	return f;
 }
 
+double KeyValueStoreSQLite::springCleaningBudgetScale() const {
+	// Only scale up while no commits are queued on the writer thread, so a large backlog uses idle time. The action
+	// drops back to the base budget once a write is queued behind it. The freed pages counted here are what vacuuming
+	// returns to the filesystem.
+	if (!SERVER_KNOBS->SPRING_CLEANING_ADAPTIVE || writesRequested != writesComplete) {
+		return 1.0;
+	}
+	return std::min(SERVER_KNOBS->SPRING_CLEANING_ADAPTIVE_MAX_SCALE,
+	                1.0 + (double)freeListPages / SERVER_KNOBS->SPRING_CLEANING_ADAPTIVE_BACKLOG_PAGES);
+}
+
 void createTemplateDatabase() {
 	ASSERT(!vfs_registered);
 	SQLiteDB db1("template.fdb", false, false);
@@ -118,6 +118,12 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( DD_QUEUE_MAX_KEY_SERVERS,                              100 ); if( randomize && BUGGIFY ) DD_QUEUE_MAX_KEY_SERVERS = 1;
 	init( DD_REBALANCE_PARALLELISM,                               50 );
 	init( DD_REBALANCE_RESET_AMOUNT,                              30 );
+	init( DD_READ_REBALANCE,                                   false ); if( randomize && BUGGIFY ) DD_READ_REBALANCE = true;
+	init( DD_READ_REBALANCE_INTERVAL,                           10.0 ); if( randomize && BUGGIFY ) DD_READ_REBALANCE_INTERVAL = 1.0;
+	init( DD_READ_REBALANCE_COOLDOWN,                           60.0 ); if( randomize && BUGGIFY ) DD_READ_REBALANCE_COOLDOWN = 5.0;
+	init( DD_READ_REBALANCE_MIN_BYTES_PER_KSEC,                  1e9 ); if( randomize && BUGGIFY ) DD_READ_REBALANCE_MIN_BYTES_PER_KSEC = 1e6;
+	init( DD_READ_REBALANCE_DIFF_RATIO,                          2.0 ); if( randomize && BUGGIFY ) DD_READ_REBALANCE_DIFF_RATIO = 1.2;
+	init( DD_READ_REBALANCE_SHARD_SAMPLES,                        20 );
 	init( BG_DD_MAX_WAIT,                                      120.0 );
 	init( BG_DD_MIN_WAIT,                                        0.1 );
 	init( BG_DD_INCREASE_RATE,                                  1.10 );
@@ -230,8 +236,13 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( DD_SHARD_SIZE_GRANULARITY,                         5000000 );
 	init( DD_SHARD_SIZE_GRANULARITY_SIM,                      500000 ); if( randomize && BUGGIFY ) DD_SHARD_SIZE_GRANULARITY_SIM = 0;
 	init( DD_MOVE_KEYS_PARALLELISM,                               15 ); if( randomize && BUGGIFY ) DD_MOVE_KEYS_PARALLELISM = 1;
+	init( DD_MOVE_KEYS_BATCH_SHARDS,                               1 ); if( randomize && BUGGIFY ) DD_MOVE_KEYS_BATCH_SHARDS = deterministicRandom()->randomInt(2, 20);
 	init( DD_FETCH_SOURCE_PARALLELISM,                          1000 ); if( randomize && BUGGIFY ) DD_FETCH_SOURCE_PARALLELISM = 1;
 	init( DD_MERGE_LIMIT,                                       2000 ); if( randomize && BUGGIFY ) DD_MERGE_LIMIT = 2;
+	init( DD_SHARD_COALESCE,                                   false ); if( randomize && BUGGIFY ) DD_SHARD_COALESCE = true;
+	init( DD_SHARD_COALESCE_INTERVAL,         isSimulated ? 10.0 : 60.0 ); if( randomize && BUGGIFY ) DD_SHARD_COALESCE_INTERVAL = 1.0;
+	init( DD_SHARD_COALESCE_MAX_SHARDS,                          500 ); if( randomize && BUGGIFY ) DD_SHARD_COALESCE_MAX_SHARDS = deterministicRandom()->randomInt(2, 10);
+	init( DD_SHARD_COALESCE_SCAN_BATCH,                         1000 ); if( randomize && BUGGIFY ) DD_SHARD_COALESCE_SCAN_BATCH = 10;
 	init( DD_SHARD_METRICS_TIMEOUT,                             60.0 ); if( randomize && BUGGIFY ) DD_SHARD_METRICS_TIMEOUT = 0.1;
 	init( DD_LOCATION_CACHE_SIZE,                            2000000 ); if( randomize && BUGGIFY ) DD_LOCATION_CACHE_SIZE = 3;
 	init( MOVEKEYS_LOCK_POLLING_DELAY,                           5.0 );
@@ -326,9 +337,15 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( SPRING_CLEANING_LAZY_DELETE_BATCH_SIZE,                100 ); if( randomize && BUGGIFY ) SPRING_CLEANING_LAZY_DELETE_BATCH_SIZE = deterministicRandom()->randomInt(1, 1000);
 	init( SPRING_CLEANING_MIN_VACUUM_PAGES,                        1 ); if( randomize && BUGGIFY ) SPRING_CLEANING_MIN_VACUUM_PAGES = deterministicRandom()->randomInt(0, 100);
 	init( SPRING_CLEANING_MAX_VACUUM_PAGES,                      1e9 ); if( randomize && BUGGIFY ) SPRING_CLEANING_MAX_VACUUM_PAGES = deterministicRandom()->coinflip() ? 0 : deterministicRandom()->randomInt(1, 1e4);
+	init( SPRING_CLEANING_VACUUM_BATCH_SIZE,                       1 ); if( randomize && BUGGIFY ) SPRING_CLEANING_VACUUM_BATCH_SIZE = deterministicRandom()->randomInt(1, 100);
+	init( SPRING_CLEANING_ADAPTIVE,                            false ); if( randomize && BUGGIFY ) SPRING_CLEANING_ADAPTIVE = true;
+	init( SPRING_CLEANING_ADAPTIVE_BACKLOG_PAGES,              25600 ); if( randomize && BUGGIFY ) SPRING_CLEANING_ADAPTIVE_BACKLOG_PAGES = deterministicRandom()->randomInt(1, 1000);
+	init( SPRING_CLEANING_ADAPTIVE_MAX_SCALE,                   10.0 ); if( randomize && BUGGIFY ) SPRING_CLEANING_ADAPTIVE_MAX_SCALE = 1 + deterministicRandom()->random01() * 100;
 
 	// KeyValueStoreMemory
 	init( REPLACE_CONTENTS_BYTES,                                1e5 );
+	init( KVSTORE_MEMORY_BULK_RECOVERY,                        false ); if( randomize && BUGGIFY ) KVSTORE_MEMORY_BULK_RECOVERY = true;
+	init( KVSTORE_MEMORY_SNAPSHOT_WRITE_RATIO,                   1.0 ); if( randomize && BUGGIFY ) KVSTORE_MEMORY_SNAPSHOT_WRITE_RATIO = deterministicRandom()->coinflip() ? 0.25 : 2.0;
 
 	// KeyValueStoreRocksDB
 	init( ROCKSDB_BACKGROUND_PARALLELISM,                          0 );
@@ -338,6 +355,16 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( ROCKSDB_PERIODIC_COMPACTION_SECONDS,                     0 );
 	init( ROCKSDB_PREFIX_LEN,                                      0 );
 	init( ROCKSDB_BLOCK_CACHE_SIZE,                                0 );
+	init( ROCKSDB_READ_WORK_STEALING,                          false ); if( randomize && BUGGIFY ) ROCKSDB_READ_WORK_STEALING = true;
+	init( ROCKSDB_READ_THREAD_CPUS,                               "" );
+	init( ROCKSDB_SHARED_RESOURCES,                            false ); if( randomize && BUGGIFY ) ROCKSDB_SHARED_RESOURCES = true;
+	init( ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC,                0 );
+	init( ROCKSDB_WRITE_BUFFER_MANAGER_BYTES,                      0 );
+	init( ROCKSDB_METRICS_DELAY,                                60.0 );
+	init( ROCKSDB_READ_VALUE_BATCHING,                         false ); if( randomize && BUGGIFY ) ROCKSDB_READ_VALUE_BATCHING = true;
+	init( ROCKSDB_READ_RANGE_REUSE_ITERATORS,                  false ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_REUSE_ITERATORS = true;
+	init( ROCKSDB_READ_RANGE_ITERATOR_IDLE_SECONDS,              5.0 ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_ITERATOR_IDLE_SECONDS = 0.1;
+	init( ROCKSDB_CLEAR_RANGE_DELETE_FILES_BYTES,           64 << 20 ); if( randomize && BUGGIFY ) ROCKSDB_CLEAR_RANGE_DELETE_FILES_BYTES = deterministicRandom()->coinflip() ? 0 : 1;
 
 	// Leader election
 	bool longLeaderElection = randomize && BUGGIFY;
@@ -501,6 +528,10 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( METRIC_UPDATE_RATE,                                     .1 ); if( slowRatekeeper ) METRIC_UPDATE_RATE = 0.5;
 	init( DETAILED_METRIC_UPDATE_RATE,                           5.0 );
 	init (RATEKEEPER_DEFAULT_LIMIT,                              1e6 ); if( randomize && BUGGIFY ) RATEKEEPER_DEFAULT_LIMIT = 0;
+	init( RATEKEEPER_PREDICTIVE_CONTROL,                       false ); if( randomize && BUGGIFY ) RATEKEEPER_PREDICTIVE_CONTROL = true;
+	init( RATEKEEPER_PREDICTIVE_HORIZON,                        10.0 ); if( randomize && BUGGIFY ) RATEKEEPER_PREDICTIVE_HORIZON = deterministicRandom()->random01() * 20.0 + 1.0;
+	init( RATEKEEPER_STORAGE_LOCAL_THROTTLE,                   false ); if( randomize && BUGGIFY ) RATEKEEPER_STORAGE_LOCAL_THROTTLE = true;
+	init( RATEKEEPER_STORAGE_LOCAL_THROTTLE_MAX_REJECT,          0.9 ); if( randomize && BUGGIFY ) RATEKEEPER_STORAGE_LOCAL_THROTTLE_MAX_REJECT = deterministicRandom()->random01() * 0.99;
 
 	bool smallStorageTarget = randomize && BUGGIFY;
 	init( TARGET_BYTES_PER_STORAGE_SERVER,                    1000e6 ); if( smallStorageTarget ) TARGET_BYTES_PER_STORAGE_SERVER = 3000e3;
@@ -549,6 +580,7 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( STORAGE_SERVER_LIST_FETCH_TIMEOUT,                    20.0 );
 
 	init( MAX_AUTO_THROTTLED_TRANSACTION_TAGS,                     5 ); if(randomize && BUGGIFY) MAX_AUTO_THROTTLED_TRANSACTION_TAGS = 1;
+	init( AUTO_THROTTLE_TAGS_PER_STORAGE_SERVER,                   1 ); if(randomize && BUGGIFY) AUTO_THROTTLE_TAGS_PER_STORAGE_SERVER = deterministicRandom()->randomInt(2, 6);
 	init( MAX_MANUAL_THROTTLED_TRANSACTION_TAGS,                  40 ); if(randomize && BUGGIFY) MAX_MANUAL_THROTTLED_TRANSACTION_TAGS = 1;
 	init( MIN_TAG_COST,                                          200 ); if(randomize && BUGGIFY) MIN_TAG_COST = 0.0;
 	init( AUTO_THROTTLE_TARGET_TAG_BUSYNESS,                     0.1 ); if(randomize && BUGGIFY) AUTO_THROTTLE_TARGET_TAG_BUSYNESS = 0.0;
@@ -580,6 +612,7 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( FETCH_BLOCK_BYTES,                                     2e6 );
 	init( FETCH_KEYS_PARALLELISM_BYTES,                          4e6 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLELISM_BYTES = 3e6;
 	init( FETCH_KEYS_LOWER_PRIORITY,                               0 );
+	init( FETCH_KEYS_BULK_LOAD,                                 true ); if( randomize && BUGGIFY ) FETCH_KEYS_BULK_LOAD = false;
 	init( BUGGIFY_BLOCK_BYTES,                                 10000 );
 	init( STORAGE_COMMIT_BYTES,                             10000000 ); if( randomize && BUGGIFY ) STORAGE_COMMIT_BYTES = 2000000;
 	init( STORAGE_DURABILITY_LAG_REJECT_THRESHOLD,              0.25 );
@@ -601,6 +634,7 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( WAIT_METRICS_WRONG_SHARD_CHANCE,   isSimulated ? 1.0 : 0.1 );
 	init( MIN_TAG_READ_PAGES_RATE,                             1.0e4 ); if( randomize && BUGGIFY ) MIN_TAG_READ_PAGES_RATE = 0;
 	init( MIN_TAG_WRITE_PAGES_RATE,                             3200 ); if( randomize && BUGGIFY ) MIN_TAG_WRITE_PAGES_RATE = 0;
+	init( STORAGE_TAG_COST_SKETCH_SIZE,                           32 ); if( randomize && BUGGIFY ) STORAGE_TAG_COST_SKETCH_SIZE = deterministicRandom()->randomInt(1, 8);
 	init( TAG_MEASUREMENT_INTERVAL,                        30.0 ); if( randomize && BUGGIFY ) TAG_MEASUREMENT_INTERVAL = 1.0;
 	init( READ_COST_BYTE_FACTOR,                          16384 ); if( randomize && BUGGIFY ) READ_COST_BYTE_FACTOR = 4096;
 	init( PREFIX_COMPRESS_KVS_MEM_SNAPSHOTS,                    true ); if( randomize && BUGGIFY ) PREFIX_COMPRESS_KVS_MEM_SNAPSHOTS = false;
@@ -685,6 +719,9 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( FASTRESTORE_TXN_CLEAR_MAX,                             100 ); if( randomize && BUGGIFY ) { FASTRESTORE_TXN_CLEAR_MAX = deterministicRandom()->random01() * 100 + 1; }
 	init( FASTRESTORE_TXN_RETRY_MAX,                              10 ); if( randomize && BUGGIFY ) { FASTRESTORE_TXN_RETRY_MAX = deterministicRandom()->random01() * 100 + 1; }
 	init( FASTRESTORE_TXN_EXTRA_DELAY,                           0.0 ); if( randomize && BUGGIFY ) { FASTRESTORE_TXN_EXTRA_DELAY = deterministicRandom()->random01() * 1 + 0.001;}
+	init( FASTRESTORE_APPLIER_BULK_WRITE,                      false ); if( randomize && BUGGIFY ) { FASTRESTORE_APPLIER_BULK_WRITE = true; }
+	init( FASTRESTORE_APPLIER_BULK_READ_VERSION_TXNS,            100 ); if( randomize && BUGGIFY ) { FASTRESTORE_APPLIER_BULK_READ_VERSION_TXNS = deterministicRandom()->randomInt(1, 10); }
+	init( FASTRESTORE_APPLIER_BULK_READ_VERSION_SECONDS,         1.0 ); if( randomize && BUGGIFY ) { FASTRESTORE_APPLIER_BULK_READ_VERSION_SECONDS = deterministicRandom()->random01() * 0.1; }
 	init( FASTRESTORE_NOT_WRITE_DB,                            false ); // Perf test only: set it to true will cause simulation failure
 	init( FASTRESTORE_USE_RANGE_FILE,                           true ); // Perf test only: set it to false will cause simulation failure
 	init( FASTRESTORE_USE_LOG_FILE,                             true ); // Perf test only: set it to false will cause simulation failure
@@ -701,17 +738,24 @@ void ServerKnobs::initialize(bool randomize, ClientKnobs* clientKnobs, bool isSi
 	init( FASTRESTORE_EXPENSIVE_VALIDATION,                    false ); if( randomize && BUGGIFY ) { FASTRESTORE_EXPENSIVE_VALIDATION = deterministicRandom()->random01() < 0.5 ? true : false;}
 	init( FASTRESTORE_WRITE_BW_MB,                                70 ); if( randomize && BUGGIFY ) { FASTRESTORE_WRITE_BW_MB = deterministicRandom()->random01() < 0.5 ? 2 : 100;}
 	init( FASTRESTORE_RATE_UPDATE_SECONDS,                       1.0 ); if( randomize && BUGGIFY ) { FASTRESTORE_RATE_UPDATE_SECONDS = deterministicRandom()->random01() < 0.5 ? 0.1 : 2;}
+	init( FASTRESTORE_LOADER_DECODE_THREADS,                     0 );
 
 	init( REDWOOD_DEFAULT_PAGE_SIZE,                            4096 );
 	init( REDWOOD_KVSTORE_CONCURRENT_READS,                       64 );
 	init( REDWOOD_COMMIT_CONCURRENT_READS,                        64 );
 	init( REDWOOD_PAGE_REBUILD_FILL_FACTOR,                     0.66 );
+	init( REDWOOD_BULK_BUILD,                                  false ); if( randomize && BUGGIFY ) REDWOOD_BULK_BUILD = true;
+	init( REDWOOD_BULK_BUILD_FILL_FACTOR,                       0.90 ); if( randomize && BUGGIFY ) REDWOOD_BULK_BUILD_FILL_FACTOR = deterministicRandom()->random01() * 0.5 + 0.5;
 	init( REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES,                    10 );
 	init( REDWOOD_LAZY_CLEAR_MIN_PAGES,                            0 );
 	init( REDWOOD_LAZY_CLEAR_MAX_PAGES,                          1e6 );
 	init( REDWOOD_REMAP_CLEANUP_WINDOW,                           50 );
 	init( REDWOOD_REMAP_CLEANUP_LAG,                             0.1 );
 	init( REDWOOD_LOGGING_INTERVAL,                              5.0 );
+	init( REDWOOD_VALUE_LOG_THRESHOLD,                             0 ); if( randomize && BUGGIFY ) REDWOOD_VALUE_LOG_THRESHOLD = deterministicRandom()->randomInt(1, 2000);
+	init( REDWOOD_VALUE_LOG_SEGMENT_BYTES,                   64 << 20 ); if( randomize && BUGGIFY ) REDWOOD_VALUE_LOG_SEGMENT_BYTES = deterministicRandom()->randomInt(1000, 1e6);
+	init( REDWOOD_VALUE_LOG_GC_MIN_BYTES,                   256 << 20 ); if( randomize && BUGGIFY ) REDWOOD_VALUE_LOG_GC_MIN_BYTES = 0;
+	init( REDWOOD_VALUE_LOG_GC_BYTES_PER_COMMIT,              4 << 20 ); if( randomize && BUGGIFY ) REDWOOD_VALUE_LOG_GC_BYTES_PER_COMMIT = deterministicRandom()->randomInt(100, 1e5);
 
 	// Server request latency measurement
 	init( LATENCY_SAMPLE_SIZE,                                100000 );
@@ -114,6 +114,12 @@ public:
 	int DD_QUEUE_MAX_KEY_SERVERS;
 	int DD_REBALANCE_PARALLELISM;
 	int DD_REBALANCE_RESET_AMOUNT;
+	bool DD_READ_REBALANCE; // Also move read-hot shards from the teams serving the most read bandwidth
+	double DD_READ_REBALANCE_INTERVAL;
+	double DD_READ_REBALANCE_COOLDOWN; // Delay after a read-driven move, which read metrics take a while to reflect
+	int64_t DD_READ_REBALANCE_MIN_BYTES_PER_KSEC; // Teams serving less read bandwidth than this are left alone
+	double DD_READ_REBALANCE_DIFF_RATIO; // The source team must serve this many times the destination's read bandwidth
+	int DD_READ_REBALANCE_SHARD_SAMPLES; // Shards of the source team sampled when choosing one to move
 	double BG_DD_MAX_WAIT;
 	double BG_DD_MIN_WAIT;
 	double BG_DD_INCREASE_RATE;
@@ -180,8 +186,13 @@ public:
 	int64_t DD_SHARD_SIZE_GRANULARITY;
 	int64_t DD_SHARD_SIZE_GRANULARITY_SIM;
 	int DD_MOVE_KEYS_PARALLELISM;
+	int DD_MOVE_KEYS_BATCH_SHARDS; // Max adjacent queued shards with the same sources launched as one health-driven move
 	int DD_FETCH_SOURCE_PARALLELISM;
 	int DD_MERGE_LIMIT;
+	bool DD_SHARD_COALESCE; // Periodically merge runs of small cold shards on the same team in bulk
+	double DD_SHARD_COALESCE_INTERVAL;
+	int DD_SHARD_COALESCE_MAX_SHARDS; // Max shards folded into one merged shard
+	int DD_SHARD_COALESCE_SCAN_BATCH; // Shards examined between yields
 	double DD_SHARD_METRICS_TIMEOUT;
 	int64_t DD_LOCATION_CACHE_SIZE;
 	double MOVEKEYS_LOCK_POLLING_DELAY;
@@ -257,9 +268,15 @@ public:
 	int SPRING_CLEANING_LAZY_DELETE_BATCH_SIZE;
 	int SPRING_CLEANING_MIN_VACUUM_PAGES;
 	int SPRING_CLEANING_MAX_VACUUM_PAGES;
+	int SPRING_CLEANING_VACUUM_BATCH_SIZE; // Pages vacuumed between yields, before adaptive scaling
+	bool SPRING_CLEANING_ADAPTIVE; // Scale spring cleaning with the free list while the writer is otherwise idle
+	int SPRING_CLEANING_ADAPTIVE_BACKLOG_PAGES; // Free pages per unit of additional scale
+	double SPRING_CLEANING_ADAPTIVE_MAX_SCALE;
 
 	// KeyValueStoreMemory
 	int64_t REPLACE_CONTENTS_BYTES;
+	bool KVSTORE_MEMORY_BULK_RECOVERY; // Rebuild recovered snapshots from sorted runs instead of one key at a time
+	double KVSTORE_MEMORY_SNAPSHOT_WRITE_RATIO; // Snapshot bytes written per byte of committed writes
 
 	// KeyValueStoreRocksDB
 	int ROCKSDB_BACKGROUND_PARALLELISM;
@@ -269,6 +286,16 @@ public:
 	int64_t ROCKSDB_PERIODIC_COMPACTION_SECONDS;
 	int ROCKSDB_PREFIX_LEN;
 	int64_t ROCKSDB_BLOCK_CACHE_SIZE;
+	bool ROCKSDB_READ_WORK_STEALING;
+	std::string ROCKSDB_READ_THREAD_CPUS; // Comma separated CPUs to pin work stealing reader threads to, in turn
+	bool ROCKSDB_SHARED_RESOURCES; // One block cache, rate limiter and write buffer manager for all stores in a process
+	int64_t ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC; // Flush and compaction budget per store (or shared); 0 disables
+	int64_t ROCKSDB_WRITE_BUFFER_MANAGER_BYTES; // Memtable budget per store (or shared); 0 disables
+	double ROCKSDB_METRICS_DELAY;
+	bool ROCKSDB_READ_VALUE_BATCHING; // Combine the point reads issued in one run loop iteration into a MultiGet
+	bool ROCKSDB_READ_RANGE_REUSE_ITERATORS;
+	double ROCKSDB_READ_RANGE_ITERATOR_IDLE_SECONDS; // Reused range iterators left idle this long are released
+	int64_t ROCKSDB_CLEAR_RANGE_DELETE_FILES_BYTES; // Min clear size that drops whole SST files; 0 disables
 
 	// Leader election
 	int MAX_NOTIFICATIONS;
@@ -425,6 +452,10 @@ public:
 	double DETAILED_METRIC_UPDATE_RATE;
 	double LAST_LIMITED_RATIO;
 	double RATEKEEPER_DEFAULT_LIMIT;
+	bool RATEKEEPER_PREDICTIVE_CONTROL; // Also limit storage servers on the extrapolated growth of their queues
+	double RATEKEEPER_PREDICTIVE_HORIZON;
+	bool RATEKEEPER_STORAGE_LOCAL_THROTTLE; // Have commit proxies reject writes to lagging storage servers only
+	double RATEKEEPER_STORAGE_LOCAL_THROTTLE_MAX_REJECT; // Highest fraction of such writes rejected; below 1
 
 	int64_t TARGET_BYTES_PER_STORAGE_SERVER;
 	int64_t SPRING_BYTES_STORAGE_SERVER;
@@ -449,6 +480,7 @@ public:
 
 	int64_t MAX_MANUAL_THROTTLED_TRANSACTION_TAGS;
 	int64_t MAX_AUTO_THROTTLED_TRANSACTION_TAGS;
+	int AUTO_THROTTLE_TAGS_PER_STORAGE_SERVER; // Busiest read and write tags considered for throttling per server
 	double MIN_TAG_COST;
 	double AUTO_THROTTLE_TARGET_TAG_BUSYNESS;
 	double AUTO_THROTTLE_RAMP_TAG_BUSYNESS;
@@ -507,6 +539,7 @@ public:
 	int FETCH_BLOCK_BYTES;
 	int FETCH_KEYS_PARALLELISM_BYTES;
 	int FETCH_KEYS_LOWER_PRIORITY;
+	bool FETCH_KEYS_BULK_LOAD; // Hand fetched blocks to IKeyValueStore::setBulk() when the store supports it
 	int BUGGIFY_BLOCK_BYTES;
 	double STORAGE_DURABILITY_LAG_REJECT_THRESHOLD;
 	double STORAGE_DURABILITY_LAG_MIN_RATE;
@@ -528,6 +561,7 @@ public:
 	double WAIT_METRICS_WRONG_SHARD_CHANCE;
 	int64_t MIN_TAG_READ_PAGES_RATE;
 	int64_t MIN_TAG_WRITE_PAGES_RATE;
+	int STORAGE_TAG_COST_SKETCH_SIZE; // Read tags a storage server tracks the cost of in each interval
 	double TAG_MEASUREMENT_INTERVAL;
 	int64_t READ_COST_BYTE_FACTOR;
 	bool PREFIX_COMPRESS_KVS_MEM_SNAPSHOTS;
@@ -618,6 +652,9 @@ public:
 	int FASTRESTORE_TXN_CLEAR_MAX; // threshold to start tracking each clear op in a txn
 	int FASTRESTORE_TXN_RETRY_MAX; // threshold to start output error on too many retries
 	double FASTRESTORE_TXN_EXTRA_DELAY; // extra delay to avoid overwhelming fdb
+	bool FASTRESTORE_APPLIER_BULK_WRITE; // apply staging keys without conflict ranges, at a shared read version
+	int FASTRESTORE_APPLIER_BULK_READ_VERSION_TXNS; // bulk transactions sharing a read version before it is refreshed
+	double FASTRESTORE_APPLIER_BULK_READ_VERSION_SECONDS; // age at which the shared bulk read version is refreshed
 	bool FASTRESTORE_NOT_WRITE_DB; // do not write result to DB. Only for dev testing
 	bool FASTRESTORE_USE_RANGE_FILE; // use range file in backup
 	bool FASTRESTORE_USE_LOG_FILE; // use log file in backup
@@ -634,11 +671,14 @@ public:
 	bool FASTRESTORE_EXPENSIVE_VALIDATION; // when set true, performance will be heavily affected
 	double FASTRESTORE_WRITE_BW_MB; // target aggregated write bandwidth from all appliers
 	double FASTRESTORE_RATE_UPDATE_SECONDS; // how long to update appliers target write rate
+	int FASTRESTORE_LOADER_DECODE_THREADS; // threads a loader decodes backup blocks on; 0 decodes on the network thread
 
 	int REDWOOD_DEFAULT_PAGE_SIZE; // Page size for new Redwood files
 	int REDWOOD_KVSTORE_CONCURRENT_READS; // Max number of simultaneous point or range reads in progress.
 	int REDWOOD_COMMIT_CONCURRENT_READS; // Max number of concurrent reads done to support commit operations
 	double REDWOOD_PAGE_REBUILD_FILL_FACTOR; // When rebuilding pages, start a new page after this capacity
+	bool REDWOOD_BULK_BUILD; // Build pages bottom-up for bulk loads hinted through IKeyValueStore::setBulk()
+	double REDWOOD_BULK_BUILD_FILL_FACTOR; // Page fill target for pages built by commits of bulk loads
 	int REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES; // Number of pages to try to pop from the lazy delete queue and process at
 	                                         // once
 	int REDWOOD_LAZY_CLEAR_MIN_PAGES; // Minimum number of pages to free before ending a lazy clear cycle, unless the
@@ -649,6 +689,10 @@ public:
 	double REDWOOD_REMAP_CLEANUP_LAG; // Maximum allowed remap remover lag behind the cleanup window as a multiple of
 	                                  // the window size
 	double REDWOOD_LOGGING_INTERVAL;
+	int REDWOOD_VALUE_LOG_THRESHOLD; // New stores keep values of at least this size in a value log; 0 disables
+	int64_t REDWOOD_VALUE_LOG_SEGMENT_BYTES; // Size at which the value log moves on to a new segment file
+	int64_t REDWOOD_VALUE_LOG_GC_MIN_BYTES; // Value log garbage collection waits for this many bytes of full segments
+	int64_t REDWOOD_VALUE_LOG_GC_BYTES_PER_COMMIT; // Value log bytes scanned for live values per commit
 
 	// Server request latency measurement
 	int LATENCY_SAMPLE_SIZE;
@@ -320,7 +320,8 @@ ACTOR static Future<Void> startMoveKeys(Database occ,
                                         MoveKeysLock lock,
                                         FlowLock* startMoveKeysLock,
                                         UID relocationIntervalId,
-                                        const DDEnabledState* ddEnabledState) {
+                                        const DDEnabledState* ddEnabledState,
+                                        int64_t* metadataTransactions) {
 	state TraceInterval interval("RelocateShard_StartMoveKeys");
 	state Future<Void> warningLogger = logWarningAfter("StartMoveKeysTooLong", 600, servers);
 	// state TraceInterval waitInterval("");
@@ -471,6 +472,9 @@ ACTOR static Future<Void> startMoveKeys(Database occ,
 					wait(waitForAll(actors));
 
 					wait(tr.commit());
+					if (metadataTransactions) {
+						++*metadataTransactions;
+					}
 
 					/*TraceEvent("StartMoveKeysCommitDone", relocationIntervalId)
 					    .detail("CommitVersion", tr.getCommittedVersion())
@@ -594,7 +598,8 @@ ACTOR static Future<Void> finishMoveKeys(Database occ,
                                          FlowLock* finishMoveKeysParallelismLock,
                                          bool hasRemote,
                                          UID relocationIntervalId,
-                                         const DDEnabledState* ddEnabledState) {
+                                         const DDEnabledState* ddEnabledState,
+                                         int64_t* metadataTransactions) {
 	state TraceInterval interval("RelocateShard_FinishMoveKeys");
 	state TraceInterval waitInterval("");
 	state Future<Void> warningLogger = logWarningAfter("FinishMoveKeysTooLong", 600, destinationTeam);
@@ -831,6 +836,9 @@ ACTOR static Future<Void> finishMoveKeys(Database occ,
 
 						wait(waitForAll(actors));
 						wait(tr.commit());
+						if (metadataTransactions) {
+							++*metadataTransactions;
+						}
 
 						begin = endKey;
 						break;
@@ -1186,11 +1194,18 @@ ACTOR Future<Void> moveKeys(Database cx,
                             FlowLock* finishMoveKeysParallelismLock,
                             bool hasRemote,
                             UID relocationIntervalId,
-                            const DDEnabledState* ddEnabledState) {
+                            const DDEnabledState* ddEnabledState,
+                            int64_t* metadataTransactions) {
 	ASSERT(destinationTeam.size());
 	std::sort(destinationTeam.begin(), destinationTeam.end());
-	wait(startMoveKeys(
-	    cx, keys, destinationTeam, lock, startMoveKeysParallelismLock, relocationIntervalId, ddEnabledState));
+	wait(startMoveKeys(cx,
+	                   keys,
+	                   destinationTeam,
+	                   lock,
+	                   startMoveKeysParallelismLock,
+	                   relocationIntervalId,
+	                   ddEnabledState,
+	                   metadataTransactions));
 
 	state Future<Void> completionSignaller =
 	    checkFetchingState(cx, healthyDestinations, keys, dataMovementComplete, relocationIntervalId);
@@ -1202,7 +1217,8 @@ ACTOR Future<Void> moveKeys(Database cx,
 	                    finishMoveKeysParallelismLock,
 	                    hasRemote,
 	                    relocationIntervalId,
-	                    ddEnabledState));
+	                    ddEnabledState,
+	                    metadataTransactions));
 
 	// This is defensive, but make sure that we always say that the movement is complete before moveKeys completes
 	completionSignaller.cancel();
@@ -53,6 +53,7 @@ struct ProxyStats {
 	    txnCommitOutSuccess, txnCommitErrors;
 	Counter txnConflicts;
 	Counter txnRejectedForQueuedTooLong;
+	Counter txnRejectedForStoragePressure;
 	Counter commitBatchIn, commitBatchOut;
 	Counter mutationBytes;
 	Counter mutations;
@@ -92,7 +93,8 @@ struct ProxyStats {
 	    txnCommitResolved("TxnCommitResolved", cc), txnCommitOut("TxnCommitOut", cc),
 	    txnCommitOutSuccess("TxnCommitOutSuccess", cc), txnCommitErrors("TxnCommitErrors", cc),
 	    txnConflicts("TxnConflicts", cc), commitBatchIn("CommitBatchIn", cc),
-	    txnRejectedForQueuedTooLong("TxnRejectedForQueuedTooLong", cc), commitBatchOut("CommitBatchOut", cc),
+	    txnRejectedForQueuedTooLong("TxnRejectedForQueuedTooLong", cc),
+	    txnRejectedForStoragePressure("TxnRejectedForStoragePressure", cc), commitBatchOut("CommitBatchOut", cc),
 	    mutationBytes("MutationBytes", cc), mutations("Mutations", cc), conflictRanges("ConflictRanges", cc),
 	    keyServerLocationIn("KeyServerLocationIn", cc), keyServerLocationOut("KeyServerLocationOut", cc),
 	    keyServerLocationErrors("KeyServerLocationErrors", cc), lastCommitVersionAssigned(0),
@@ -172,6 +174,7 @@ struct ProxyCommitData {
 
 	vector<double> commitComputePerOperation;
 	UIDTransactionTagMap<TransactionCommitCostEstimation> ssTrTagCommitCost;
+	std::map<UID, double> storageWritePressure; // From ratekeeper, see RATEKEEPER_STORAGE_LOCAL_THROTTLE
 	double lastMasterReset;
 	double lastResolverReset;
 
@@ -188,6 +191,34 @@ struct ProxyCommitData {
 		return tags;
 	}
 
+	// Returns the largest write pressure ratekeeper has reported for any storage server the transaction's mutations
+	// would be sent to, or 0 if none of them are under pressure. Transactions touching system keys are never held
+	// back, since recovery and metadata changes must not wait on a slow storage server.
+	double storageWritePressureFor(const CommitTransactionRef& tr) {
+		double pressure = 0;
+		auto addPressure = [&](const ServerCacheInfo& info) {
+			for (const auto& ssInfo : info.src_info) {
+				auto it = storageWritePressure.find(ssInfo->interf.id());
+				if (it != storageWritePressure.end()) {
+					pressure = std::max(pressure, it->second);
+				}
+			}
+		};
+		for (const auto& m : tr.mutations) {
+			if (m.param1.startsWith(systemKeys.begin)) {
+				return 0;
+			}
+			if (isSingleKeyMutation((MutationRef::Type)m.type)) {
+				addPressure(keyInfo[m.param1]);
+			} else if (m.type == MutationRef::ClearRange) {
+				for (auto r : keyInfo.intersectingRanges(KeyRangeRef(m.param1, m.param2))) {
+					addPressure(r.value());
+				}
+			}
+		}
+		return pressure;
+	}
+
 	bool needsCacheTag(KeyRangeRef range) {
 		auto ranges = cacheInfo.intersectingRanges(range);
 		for (auto r : ranges) {
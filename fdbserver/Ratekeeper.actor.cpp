@@ -93,9 +93,8 @@ struct StorageQueueInfo {
 	Smoother smoothTotalSpace;
 	limitReason_t limitReason;
 
-	Optional<TransactionTag> busiestReadTag, busiestWriteTag;
-	double busiestReadTagFractionalBusyness = 0, busiestWriteTagFractionalBusyness = 0;
-	double busiestReadTagRate = 0, busiestWriteTagRate = 0;
+	// The busiest few tags on this server, busiest first
+	std::vector<BusyTagInfo> busiestReadTags, busiestWriteTags;
 
 	// refresh periodically
 	TransactionTagMap<TransactionCommitCostEstimation> tagCostEst;
@@ -572,6 +571,10 @@ struct RatekeeperData {
 
 	bool autoThrottlingEnabled;
 
+	// Storage servers whose writes commit proxies should hold back locally, with the fraction of those writes to
+	// reject. Only populated with RATEKEEPER_STORAGE_LOCAL_THROTTLE.
+	std::map<UID, double> storageWritePressure;
+
 	RatekeeperData(UID id, Database db)
 	  : id(id), db(db), smoothReleasedTransactions(SERVER_KNOBS->SMOOTHING_AMOUNT),
 	    smoothBatchReleasedTransactions(SERVER_KNOBS->SMOOTHING_AMOUNT),
@@ -633,9 +636,13 @@ ACTOR Future<Void> trackStorageServerQueueInfo(RatekeeperData* self, StorageServ
 					myQueueInfo->value.smoothLatestVersion.setTotal(reply.get().version);
 				}
 
-				myQueueInfo->value.busiestReadTag = reply.get().busiestTag;
-				myQueueInfo->value.busiestReadTagFractionalBusyness = reply.get().busiestTagFractionalBusyness;
-				myQueueInfo->value.busiestReadTagRate = reply.get().busiestTagRate;
+				myQueueInfo->value.busiestReadTags = reply.get().busiestTags;
+				if (myQueueInfo->value.busiestReadTags.empty() && reply.get().busiestTag.present()) {
+					// From a storage server that only reports its single busiest tag
+					myQueueInfo->value.busiestReadTags.emplace_back(reply.get().busiestTag.get(),
+					                                                reply.get().busiestTagRate,
+					                                                reply.get().busiestTagFractionalBusyness);
+				}
 			} else {
 				if (myQueueInfo->value.valid) {
 					TraceEvent("RkStorageServerDidNotRespond", self->id).detail("StorageServer", ssi.id());
@@ -881,36 +888,36 @@ Future<Void> refreshStorageServerCommitCost(RatekeeperData* self) {
 		return Void();
 	}
 	double elapsed = now() - self->lastBusiestCommitTagPick;
-	// for each SS, select the busiest commit tag from ssTrTagCommitCost
+	// for each SS, select the busiest commit tags from ssTrTagCommitCost. Commit costs are aggregated exactly from the
+	// commit proxies' estimates, so no sketch is needed to find the top few.
 	for (auto it = self->storageQueueInfo.begin(); it != self->storageQueueInfo.end(); ++it) {
-		it->value.busiestWriteTag.reset();
-		TransactionTag busiestTag;
-		TransactionCommitCostEstimation maxCost;
-		double maxRate = 0, maxBusyness = 0;
-		for (const auto& [tag, cost] : it->value.tagCostEst) {
-			double rate = cost.getCostSum() / elapsed;
-			if (rate > maxRate) {
-				busiestTag = tag;
-				maxRate = rate;
-				maxCost = cost;
+		it->value.busiestWriteTags.clear();
+		std::vector<std::pair<TransactionTag, TransactionCommitCostEstimation>> costs(it->value.tagCostEst.begin(),
+		                                                                             it->value.tagCostEst.end());
+		int count = std::min<int>(costs.size(), SERVER_KNOBS->AUTO_THROTTLE_TAGS_PER_STORAGE_SERVER);
+		std::partial_sort(costs.begin(), costs.begin() + count, costs.end(), [](auto const& a, auto const& b) {
+			return a.second.getCostSum() > b.second.getCostSum();
+		});
+		for (int i = 0; i < count; i++) {
+			double rate = costs[i].second.getCostSum() / elapsed;
+			if (rate > SERVER_KNOBS->MIN_TAG_WRITE_PAGES_RATE) {
+				// TraceEvent("RefreshSSCommitCost").detail("TotalWriteCost", it->value.totalWriteCost).detail("TotalWriteOps",it->value.totalWriteOps);
+				ASSERT(it->value.totalWriteCosts > 0);
+				double busyness = double(costs[i].second.getCostSum()) / it->value.totalWriteCosts;
+				it->value.busiestWriteTags.emplace_back(costs[i].first, rate, busyness);
 			}
 		}
-		if (maxRate > SERVER_KNOBS->MIN_TAG_WRITE_PAGES_RATE) {
-			it->value.busiestWriteTag = busiestTag;
-			// TraceEvent("RefreshSSCommitCost").detail("TotalWriteCost", it->value.totalWriteCost).detail("TotalWriteOps",it->value.totalWriteOps);
-			ASSERT(it->value.totalWriteCosts > 0);
-			maxBusyness = double(maxCost.getCostSum()) / it->value.totalWriteCosts;
-			it->value.busiestWriteTagFractionalBusyness = maxBusyness;
-			it->value.busiestWriteTagRate = maxRate;
-		}
 
+		TransactionTag busiestTag = count > 0 ? costs[0].first : TransactionTag();
+		TransactionCommitCostEstimation maxCost = count > 0 ? costs[0].second : TransactionCommitCostEstimation();
 		TraceEvent("BusiestWriteTag", it->key)
 		    .detail("Elapsed", elapsed)
 		    .detail("Tag", printable(busiestTag))
 		    .detail("TagOps", maxCost.getOpsSum())
 		    .detail("TagCost", maxCost.getCostSum())
 		    .detail("TotalCost", it->value.totalWriteCosts)
-		    .detail("Reported", it->value.busiestWriteTag.present())
+		    .detail("Reported", !it->value.busiestWriteTags.empty())
+		    .detail("ReportedTags", it->value.busiestWriteTags.size())
 		    .trackLatest(it->key.toString() + "/BusiestWriteTag");
 
 		// reset statistics
@@ -957,19 +964,14 @@ void tryAutoThrottleTag(RatekeeperData* self,
 	// future
 	if (storageQueue > SERVER_KNOBS->AUTO_TAG_THROTTLE_STORAGE_QUEUE_BYTES ||
 	    storageDurabilityLag > SERVER_KNOBS->AUTO_TAG_THROTTLE_DURABILITY_LAG_VERSIONS) {
-		if (ss.busiestWriteTag.present()) {
-			tryAutoThrottleTag(self,
-			                   ss.busiestWriteTag.get(),
-			                   ss.busiestWriteTagRate,
-			                   ss.busiestWriteTagFractionalBusyness,
-			                   TagThrottledReason::BUSY_WRITE);
+		// Each tag is throttled in proportion to its own share of the server's cost
+		for (const auto& busyTag : ss.busiestWriteTags) {
+			tryAutoThrottleTag(
+			    self, busyTag.tag, busyTag.rate, busyTag.fractionalBusyness, TagThrottledReason::BUSY_WRITE);
 		}
-		if (ss.busiestReadTag.present()) {
-			tryAutoThrottleTag(self,
-			                   ss.busiestReadTag.get(),
-			                   ss.busiestReadTagRate,
-			                   ss.busiestReadTagFractionalBusyness,
-			                   TagThrottledReason::BUSY_READ);
+		for (const auto& busyTag : ss.busiestReadTags) {
+			tryAutoThrottleTag(
+			    self, busyTag.tag, busyTag.rate, busyTag.fractionalBusyness, TagThrottledReason::BUSY_READ);
 		}
 	}
 }
@@ -994,6 +996,14 @@ void updateRate(RatekeeperData* self, RatekeeperLimits* limits) {
 	limitReason_t limitReason = limitReason_t::unlimited;
 
 	int sscount = 0;
+	int predictiveLimitedServers = 0;
+	double worstWritePressure = 0;
+	UID worstWritePressureID;
+	bool localThrottle =
+	    SERVER_KNOBS->RATEKEEPER_STORAGE_LOCAL_THROTTLE && limits->priority == TransactionPriority::DEFAULT;
+	if (localThrottle) {
+		self->storageWritePressure.clear();
+	}
 
 	int64_t worstFreeSpaceStorageServer = std::numeric_limits<int64_t>::max();
 	int64_t worstStorageQueueStorageServer = 0;
@@ -1002,6 +1012,7 @@ void updateRate(RatekeeperData* self, RatekeeperLimits* limits) {
 
 	std::multimap<double, StorageQueueInfo*> storageTpsLimitReverseIndex;
 	std::multimap<int64_t, StorageQueueInfo*> storageDurabilityLagReverseIndex;
+	std::multimap<double, StorageQueueInfo*, std::greater<double>> storageWritePressureIndex;
 
 	std::map<UID, limitReason_t> ssReasons;
 
@@ -1047,7 +1058,19 @@ void updateRate(RatekeeperData* self, RatekeeperLimits* limits) {
 		ssMetrics.cpuUsage = ss.lastReply.cpuUsage;
 		ssMetrics.diskUsage = ss.lastReply.diskUsage;
 
-		double targetRateRatio = std::min((storageQueue - targetBytes + springBytes) / (double)springBytes, 2.0);
+		// With local throttling, commit proxies start rejecting writes to this server alone once its queue passes
+		// targetBytes - springBytes, rejecting all of them at targetBytes. The cluster-wide controller is then
+		// shifted up by one spring so that it only takes over if local throttling cannot hold the queue.
+		int64_t queueTargetBytes = targetBytes;
+		if (localThrottle && targetBytes == limits->storageTargetBytes) {
+			double pressure = std::min(1.0, (storageQueue - (targetBytes - springBytes)) / (double)springBytes);
+			if (pressure > 0) {
+				storageWritePressureIndex.insert(std::make_pair(pressure, &ss));
+			}
+			queueTargetBytes += springBytes;
+		}
+
+		double targetRateRatio = std::min((storageQueue - queueTargetBytes + springBytes) / (double)springBytes, 2.0);
 
 		if (limits->priority == TransactionPriority::DEFAULT) {
 			tryAutoThrottleTag(self, ss, storageQueue, storageDurabilityLag);
@@ -1098,6 +1121,31 @@ void updateRate(RatekeeperData* self, RatekeeperLimits* limits) {
 			}
 		}
 
+		// The spring controller above only reacts once the queue is already past targetBytes - springBytes, and
+		// releases the limit as soon as the queue drains back, which makes heavy write loads sawtooth. Instead,
+		// extrapolate the queue's growth and limit the input rate so that the queue would only reach the start of
+		// the spring region after RATEKEEPER_PREDICTIVE_HORIZON seconds.
+		if (SERVER_KNOBS->RATEKEEPER_PREDICTIVE_CONTROL && inputRate > 0) {
+			double durableRate = ss.smoothDurableBytes.smoothRate();
+			double horizon = SERVER_KNOBS->RATEKEEPER_PREDICTIVE_HORIZON;
+			double queueGrowth = inputRate - durableRate;
+			if (queueGrowth > 0 && storageQueue + queueGrowth * horizon > queueTargetBytes - springBytes) {
+				double allowedInputRate = durableRate + (queueTargetBytes - springBytes - storageQueue) / horizon;
+				// Past the start of the spring region the spring controller is in charge; just keep the prediction
+				// from driving the limit down faster than it would.
+				allowedInputRate = std::max(allowedInputRate, 0.5 * std::max(durableRate, 0.0));
+				double lim = actualTps * allowedInputRate / inputRate;
+				if (lim < limitTps) {
+					limitTps = lim;
+					++predictiveLimitedServers;
+					if (ssLimitReason == limitReason_t::unlimited ||
+					    ssLimitReason == limitReason_t::storage_server_write_bandwidth_mvcc) {
+						ssLimitReason = limitReason_t::storage_server_write_queue_size;
+					}
+				}
+			}
+		}
+
 		storageTpsLimitReverseIndex.insert(std::make_pair(limitTps, &ss));
 
 		if (limitTps < limits->tpsLimit && (ssLimitReason == limitReason_t::storage_server_min_free_space ||
@@ -1110,6 +1158,30 @@ void updateRate(RatekeeperData* self, RatekeeperLimits* limits) {
 		ssReasons[ss.id] = ssLimitReason;
 	}
 
+	// Like the cluster-wide limit below, local throttling ignores the worst machines that are allowed to fall behind,
+	// so that a single slow disk does not block writes to its shards.
+	std::set<Optional<Standalone<StringRef>>> ignoredWritePressureMachines;
+	for (const auto& [pressure, ss] : storageWritePressureIndex) {
+		if (ignoredWritePressureMachines.size() <
+		    std::min(self->configuration.storageTeamSize - 1, SERVER_KNOBS->MAX_MACHINES_FALLING_BEHIND)) {
+			ignoredWritePressureMachines.insert(ss->locality.zoneId());
+			continue;
+		}
+		if (ignoredWritePressureMachines.count(ss->locality.zoneId()) > 0) {
+			continue;
+		}
+		self->storageWritePressure[ss->id] = pressure;
+		if (pressure > worstWritePressure) {
+			worstWritePressure = pressure;
+			worstWritePressureID = ss->id;
+		}
+		TraceEvent("RkStorageWritePressure", self->id)
+		    .suppressFor(1.0)
+		    .detail("StorageServer", ss->id)
+		    .detail("Pressure", pressure)
+		    .detail("StorageQueue", ss->lastReply.bytesInput - ss->smoothDurableBytes.smoothTotal());
+	}
+
 	std::set<Optional<Standalone<StringRef>>> ignoredMachines;
 	for (auto ss = storageTpsLimitReverseIndex.begin();
 	     ss != storageTpsLimitReverseIndex.end() && ss->first < limits->tpsLimit;
@@ -1340,6 +1412,11 @@ void updateRate(RatekeeperData* self, RatekeeperLimits* limits) {
 		    .detail("ReleasedBatchTPS", self->smoothBatchReleasedTransactions.smoothRate())
 		    .detail("TPSBasis", actualTps)
 		    .detail("StorageServers", sscount)
+		    .detail("PredictiveLimitedStorageServers", predictiveLimitedServers)
+		    .detail("LocallyThrottledStorageServers", localThrottle ? self->storageWritePressure.size() : 0)
+		    .detail("WorstStorageWritePressure", worstWritePressure)
+		    .detail("WorstStorageWritePressureServerID",
+		            worstWritePressureID == UID() ? std::string() : Traceable<UID>::toString(worstWritePressureID))
 		    .detail("GrvProxies", self->grvProxyInfo.size())
 		    .detail("TLogs", tlcount)
 		    .detail("WorstFreeSpaceStorageServer", worstFreeSpaceStorageServer)
@@ -1513,7 +1590,9 @@ ACTOR Future<Void> ratekeeper(RatekeeperInterface rkInterf, Reference<AsyncVar<S
 			}
 			when(ReportCommitCostEstimationRequest req = waitNext(rkInterf.reportCommitCostEstimation.getFuture())) {
 				updateCommitCostEstimation(&self, req.ssTrTagCommitCost);
-				req.reply.send(Void());
+				ReportCommitCostEstimationReply reply;
+				reply.storageWritePressure = self.storageWritePressure;
+				req.reply.send(reply);
 			}
 			when(wait(err.getFuture())) {}
 			when(wait(dbInfo->onChange())) {
@@ -158,10 +158,21 @@ struct HaltRatekeeperRequest {
 	}
 };
 
+struct ReportCommitCostEstimationReply {
+	constexpr static FileIdentifier file_identifier = 4093126;
+	// Storage servers whose writes the commit proxy should reject locally, with the fraction of writes to reject
+	std::map<UID, double> storageWritePressure;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, storageWritePressure);
+	}
+};
+
 struct ReportCommitCostEstimationRequest {
 	constexpr static FileIdentifier file_identifier = 8314904;
 	UIDTransactionTagMap<TransactionCommitCostEstimation> ssTrTagCommitCost;
-	ReplyPromise<Void> reply;
+	ReplyPromise<ReportCommitCostEstimationReply> reply;
 
 	ReportCommitCostEstimationRequest() {}
 	ReportCommitCostEstimationRequest(UIDTransactionTagMap<TransactionCommitCostEstimation> ssTrTagCommitCost)
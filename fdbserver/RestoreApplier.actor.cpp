@@ -503,7 +503,48 @@ ACTOR static Future<Void> shouldReleaseTransaction(double* targetMB,
 	return Void();
 }
 
+// Read version shared by the bulk transactions of a version batch. Sharing it saves a GRV per transaction, but the GRV
+// is also where ratekeeper throttles the applier, so the version is refreshed every
+// FASTRESTORE_APPLIER_BULK_READ_VERSION_TXNS transactions or FASTRESTORE_APPLIER_BULK_READ_VERSION_SECONDS seconds.
+// Throttling then holds back at most that many transactions' worth of writes at a time rather than each transaction.
+struct BulkReadVersion {
+	Future<Version> version;
+	int uses = 0;
+	double fetchTime = 0;
+};
+
+ACTOR static Future<Version> fetchBulkReadVersion(Database cx) {
+	state Transaction tr(cx);
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			Version v = wait(tr.getReadVersion());
+			return v;
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+}
+
+// The shared read version for the next bulk transaction, or invalidVersion if bulk writes are disabled
+static Future<Version> getBulkReadVersion(Database cx, BulkReadVersion* shared) {
+	if (!SERVER_KNOBS->FASTRESTORE_APPLIER_BULK_WRITE || SERVER_KNOBS->FASTRESTORE_NOT_WRITE_DB) {
+		return invalidVersion;
+	}
+	if (!shared->version.isValid() || shared->uses >= SERVER_KNOBS->FASTRESTORE_APPLIER_BULK_READ_VERSION_TXNS ||
+	    now() - shared->fetchTime >= SERVER_KNOBS->FASTRESTORE_APPLIER_BULK_READ_VERSION_SECONDS) {
+		shared->version = fetchBulkReadVersion(cx);
+		shared->uses = 0;
+		shared->fetchTime = now();
+	}
+	++shared->uses;
+	return shared->version;
+}
+
 // Apply mutations in batchData->stagingKeys [begin, end).
+// If bulkReadVersion gives a valid version, the first attempt commits at it without conflict ranges. The database is
+// locked during restore and every staging key is written by exactly one transaction of the version batch, so there is
+// nothing for the resolvers to check. Retries fall back to a normal transaction.
 ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::iterator begin,
                                                 std::map<Key, StagingKey>::iterator end,
                                                 Database cx,
@@ -512,13 +553,15 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
                                                 double* appliedBytes,
                                                 double* applyingDataBytes,
                                                 double* targetMB,
-                                                AsyncTrigger* releaseTxnTrigger) {
+                                                AsyncTrigger* releaseTxnTrigger,
+                                                BulkReadVersion* bulkReadVersion) {
 	if (SERVER_KNOBS->FASTRESTORE_NOT_WRITE_DB) {
 		TraceEvent("FastRestoreApplierPhaseApplyStagingKeysBatchSkipped", applierID).detail("Begin", begin->first);
 		ASSERT(!g_network->isSimulated());
 		return Void();
 	}
 	wait(shouldReleaseTransaction(targetMB, applyingDataBytes, releaseTxnTrigger));
+	state Version readVersion = wait(getBulkReadVersion(cx, bulkReadVersion));
 
 	state Reference<ReadYourWritesTransaction> tr(new ReadYourWritesTransaction(cx));
 	state int sets = 0;
@@ -526,6 +569,7 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 	state Key endKey = begin->first;
 	state double txnSize = 0;
 	state double txnSizeUsed = 0; // txn size accounted in applyingDataBytes
+	state bool bulk = readVersion != invalidVersion;
 	TraceEvent(SevFRDebugInfo, "FastRestoreApplierPhaseApplyStagingKeysBatch", applierID).detail("Begin", begin->first);
 	loop {
 		try {
@@ -533,8 +577,16 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 			txnSizeUsed = 0;
 			tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
 			tr->setOption(FDBTransactionOptions::LOCK_AWARE);
+			if (bulk) {
+				// Without this, the commit would add a read conflict range that is too old at readVersion
+				tr->setOption(FDBTransactionOptions::CAUSAL_WRITE_RISKY);
+				tr->setVersion(readVersion);
+			}
 			std::map<Key, StagingKey>::iterator iter = begin;
 			while (iter != end) {
+				if (bulk) {
+					tr->setOption(FDBTransactionOptions::NEXT_WRITE_NO_WRITE_CONFLICT_RANGE);
+				}
 				if (iter->second.type == MutationRef::SetValue) {
 					tr->set(iter->second.key, iter->second.val);
 					txnSize += iter->second.totalSize();
@@ -573,11 +625,16 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 			    .detail("End", endKey)
 			    .detail("Sets", sets)
 			    .detail("Clears", clears);
-			tr->addWriteConflictRange(KeyRangeRef(begin->first, keyAfter(endKey))); // Reduce resolver load
+			if (!bulk) {
+				tr->addWriteConflictRange(KeyRangeRef(begin->first, keyAfter(endKey))); // Reduce resolver load
+			}
 			txnSizeUsed = txnSize;
 			*applyingDataBytes += txnSizeUsed; // Must account for applying bytes before wait for write traffic control
 			wait(tr->commit());
 			cc->appliedTxns += 1;
+			if (bulk) {
+				cc->appliedBulkTxns += 1;
+			}
 			cc->appliedBytes += txnSize;
 			*appliedBytes += txnSize;
 			*applyingDataBytes -= txnSizeUsed;
@@ -587,6 +644,10 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 			break;
 		} catch (Error& e) {
 			cc->appliedTxnRetries += 1;
+			if (bulk) {
+				bulk = false;
+				cc->bulkTxnFallbacks += 1;
+			}
 			wait(tr->onError(e));
 			*applyingDataBytes -= txnSizeUsed;
 		}
@@ -599,6 +660,7 @@ ACTOR static Future<Void> applyStagingKeys(Reference<ApplierBatchData> batchData
                                            UID applierID,
                                            int64_t batchIndex,
                                            Database cx) {
+	state BulkReadVersion bulkReadVersion;
 	std::map<Key, StagingKey>::iterator begin = batchData->stagingKeys.begin();
 	std::map<Key, StagingKey>::iterator cur = begin;
 	state int txnBatches = 0;
@@ -606,7 +668,8 @@ ACTOR static Future<Void> applyStagingKeys(Reference<ApplierBatchData> batchData
 	std::vector<Future<Void>> fBatches;
 	TraceEvent("FastRestoreApplerPhaseApplyStagingKeysStart", applierID)
 	    .detail("BatchIndex", batchIndex)
-	    .detail("StagingKeys", batchData->stagingKeys.size());
+	    .detail("StagingKeys", batchData->stagingKeys.size())
+	    .detail("BulkWrite", SERVER_KNOBS->FASTRESTORE_APPLIER_BULK_WRITE);
 	batchData->totalBytesToWrite = 0;
 	while (cur != batchData->stagingKeys.end()) {
 		txnSize += cur->second.totalSize(); // should be consistent with receivedBytes accounting method
@@ -619,7 +682,8 @@ ACTOR static Future<Void> applyStagingKeys(Reference<ApplierBatchData> batchData
 			                                         &batchData->appliedBytes,
 			                                         &batchData->applyingDataBytes,
 			                                         &batchData->targetWriteRateMB,
-			                                         &batchData->releaseTxnTrigger));
+			                                         &batchData->releaseTxnTrigger,
+			                                         &bulkReadVersion));
 			batchData->totalBytesToWrite += txnSize;
 			begin = cur;
 			txnSize = 0;
@@ -636,7 +700,8 @@ ACTOR static Future<Void> applyStagingKeys(Reference<ApplierBatchData> batchData
 		                                         &batchData->appliedBytes,
 		                                         &batchData->applyingDataBytes,
 		                                         &batchData->targetWriteRateMB,
-		                                         &batchData->releaseTxnTrigger));
+		                                         &batchData->releaseTxnTrigger,
+		                                         &bulkReadVersion));
 		batchData->totalBytesToWrite += txnSize;
 		txnBatches++;
 	}
@@ -647,7 +712,9 @@ ACTOR static Future<Void> applyStagingKeys(Reference<ApplierBatchData> batchData
 	    .detail("BatchIndex", batchIndex)
 	    .detail("StagingKeys", batchData->stagingKeys.size())
 	    .detail("TransactionBatches", txnBatches)
-	    .detail("TotalBytesToWrite", batchData->totalBytesToWrite);
+	    .detail("TotalBytesToWrite", batchData->totalBytesToWrite)
+	    .detail("AppliedBulkTxns", batchData->counters.appliedBulkTxns.getValue())
+	    .detail("BulkTxnFallbacks", batchData->counters.bulkTxnFallbacks.getValue());
 	return Void();
 }
 
@@ -264,6 +264,7 @@ struct ApplierBatchData : public ReferenceCounted<ApplierBatchData> {
 		Counter receivedBytes, receivedWeightedBytes, receivedMutations, receivedAtomicOps;
 		Counter appliedBytes, appliedWeightedBytes, appliedMutations, appliedAtomicOps;
 		Counter appliedTxns, appliedTxnRetries;
+		Counter appliedBulkTxns, bulkTxnFallbacks; // txns applied in bulk mode, and those retried as normal txns
 		Counter fetchKeys, fetchTxns, fetchTxnRetries; // number of keys to fetch from dest. FDB cluster.
 		Counter clearOps, clearTxns;
 
@@ -273,7 +274,8 @@ struct ApplierBatchData : public ReferenceCounted<ApplierBatchData> {
 		    receivedAtomicOps("ReceivedAtomicOps", cc), receivedWeightedBytes("ReceivedWeightedMutations", cc),
 		    appliedBytes("AppliedBytes", cc), appliedWeightedBytes("AppliedWeightedBytes", cc),
 		    appliedMutations("AppliedMutations", cc), appliedAtomicOps("AppliedAtomicOps", cc),
-		    appliedTxns("AppliedTxns", cc), appliedTxnRetries("AppliedTxnRetries", cc), fetchKeys("FetchKeys", cc),
+		    appliedTxns("AppliedTxns", cc), appliedTxnRetries("AppliedTxnRetries", cc),
+		    appliedBulkTxns("AppliedBulkTxns", cc), bulkTxnFallbacks("BulkTxnFallbacks", cc), fetchKeys("FetchKeys", cc),
 		    fetchTxns("FetchTxns", cc), fetchTxnRetries("FetchTxnRetries", cc), clearOps("ClearOps", cc),
 		    clearTxns("ClearTxns", cc) {}
 	} counters;
@@ -78,6 +78,7 @@ ACTOR static Future<Void> _parseRangeFileToMutationsOnLoader(
     std::map<LoadingParam, SampledMutationsVec>::iterator samplesIter,
     LoaderCounters* cc,
     Reference<IBackupContainer> bc,
+    Reference<IThreadPool> decodeThreads,
     Version version,
     RestoreAsset asset);
 ACTOR Future<Void> handleFinishVersionBatchRequest(RestoreVersionBatchRequest req, Reference<RestoreLoaderData> self);
@@ -363,6 +364,129 @@ void handleRestoreSysInfoRequest(const RestoreSysInfoRequest& req, Reference<Res
 
 // Parse a data block in a partitioned mutation log file and store mutations
 // into "kvOpsIter" and samples into "samplesIter".
+// Parses the messages of a partitioned log block written by saveMutationsToFile(), keeping those at versions in
+// [beginVersion, endVersion). The mutations point into the block's arena.
+static VersionedMutationsVec decodePartitionedLogBlockData(Standalone<StringRef> buf,
+                                                           Version beginVersion,
+                                                           Version endVersion) {
+	VersionedMutationsVec results;
+	results.arena().dependsOn(buf.arena());
+	StringRefReader reader(buf, restore_corrupted_data());
+
+	// Read block header
+	if (reader.consume<int32_t>() != PARTITIONED_MLOG_VERSION)
+		throw restore_unsupported_file_version();
+
+	while (1) {
+		// If eof reached or first key len bytes is 0xFF then end of block was reached.
+		if (reader.eof() || *reader.rptr == 0xFF)
+			break;
+
+		// Deserialize messages written in saveMutationsToFile().
+		LogMessageVersion msgVersion;
+		msgVersion.version = reader.consumeNetworkUInt64();
+		msgVersion.sub = reader.consumeNetworkUInt32();
+		int msgSize = reader.consumeNetworkInt32();
+		const uint8_t* message = reader.consume(msgSize);
+
+		// Skip mutations out of the version range
+		if (msgVersion.version < beginVersion || msgVersion.version >= endVersion)
+			continue;
+
+		ArenaReader rd(results.arena(), StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
+		MutationRef mutation;
+		rd >> mutation;
+		results.push_back(results.arena(), VersionedMutation(mutation, msgVersion));
+	}
+
+	// Make sure any remaining bytes in the block are 0xFF
+	for (auto b : reader.remainder()) {
+		if (b != 0xFF)
+			throw restore_corrupted_data_padding();
+	}
+	return results;
+}
+
+// Decodes backup file blocks on the loader's decode threads. Actions only turn bytes into key-values or mutations;
+// everything that reads loader state, updates counters or traces stays on the network thread.
+struct RestoreBlockDecoder : IThreadPoolReceiver {
+	void init() override {}
+
+	struct DecodeRangeBlockAction : TypedAction<RestoreBlockDecoder, DecodeRangeBlockAction> {
+		Standalone<StringRef> block;
+		ThreadReturnPromise<Standalone<VectorRef<KeyValueRef>>> result;
+		explicit DecodeRangeBlockAction(Standalone<StringRef>&& block) : block(std::move(block)) {}
+		double getTimeEstimate() const override { return 0; }
+	};
+	void action(DecodeRangeBlockAction& a) {
+		try {
+			StringRefReader reader(a.block, restore_corrupted_data());
+			Standalone<VectorRef<KeyValueRef>> kvs = fileBackup::decodeRangeFileBlockData(a.block, reader);
+			a.block = Standalone<StringRef>();
+			a.result.send(kvs);
+		} catch (Error& e) {
+			a.result.sendError(e);
+		}
+	}
+
+	struct DecodePartitionedLogBlockAction : TypedAction<RestoreBlockDecoder, DecodePartitionedLogBlockAction> {
+		Standalone<StringRef> block;
+		Version beginVersion, endVersion;
+		ThreadReturnPromise<VersionedMutationsVec> result;
+		DecodePartitionedLogBlockAction(Standalone<StringRef>&& block, Version beginVersion, Version endVersion)
+		  : block(std::move(block)), beginVersion(beginVersion), endVersion(endVersion) {}
+		double getTimeEstimate() const override { return 0; }
+	};
+	void action(DecodePartitionedLogBlockAction& a) {
+		try {
+			VersionedMutationsVec mutations = decodePartitionedLogBlockData(a.block, a.beginVersion, a.endVersion);
+			a.block = Standalone<StringRef>();
+			a.result.send(mutations);
+		} catch (Error& e) {
+			a.result.sendError(e);
+		}
+	}
+};
+
+Reference<IThreadPool> createRestoreDecodeThreads() {
+	// Real threads would make simulation nondeterministic, so simulated loaders always decode inline
+	if (SERVER_KNOBS->FASTRESTORE_LOADER_DECODE_THREADS <= 0 || g_network->isSimulated()) {
+		return Reference<IThreadPool>();
+	}
+	Reference<IThreadPool> threads = createGenericThreadPool();
+	for (int i = 0; i < SERVER_KNOBS->FASTRESTORE_LOADER_DECODE_THREADS; ++i) {
+		threads->addThread(new RestoreBlockDecoder(), "fdb-restore-dec");
+	}
+	return threads;
+}
+
+// The decode functions take the only reference to block, because arena reference counts are not thread safe. Without
+// decode threads, blocks are decoded inline.
+static Future<Standalone<VectorRef<KeyValueRef>>> decodeRangeBlock(Reference<IThreadPool> decodeThreads,
+                                                                   Standalone<StringRef>&& block) {
+	if (!decodeThreads) {
+		StringRefReader reader(block, restore_corrupted_data());
+		return fileBackup::decodeRangeFileBlockData(block, reader);
+	}
+	auto a = new RestoreBlockDecoder::DecodeRangeBlockAction(std::move(block));
+	auto f = a->result.getFuture();
+	decodeThreads->post(a);
+	return f;
+}
+
+static Future<VersionedMutationsVec> decodePartitionedLogBlock(Reference<IThreadPool> decodeThreads,
+                                                               Standalone<StringRef>&& block,
+                                                               Version beginVersion,
+                                                               Version endVersion) {
+	if (!decodeThreads) {
+		return decodePartitionedLogBlockData(block, beginVersion, endVersion);
+	}
+	auto a = new RestoreBlockDecoder::DecodePartitionedLogBlockAction(std::move(block), beginVersion, endVersion);
+	auto f = a->result.getFuture();
+	decodeThreads->post(a);
+	return f;
+}
+
 ACTOR static Future<Void> _parsePartitionedLogFileOnLoader(
     KeyRangeMap<Version>* pRangeVersions,
     NotifiedVersion* processedFileOffset,
@@ -370,6 +494,7 @@ ACTOR static Future<Void> _parsePartitionedLogFileOnLoader(
     std::map<LoadingParam, SampledMutationsVec>::iterator samplesIter,
     LoaderCounters* cc,
     Reference<IBackupContainer> bc,
+    Reference<IThreadPool> decodeThreads,
     RestoreAsset asset) {
 	state Standalone<StringRef> buf = makeString(asset.len);
 	state Reference<IAsyncFile> file = wait(bc->readFile(asset.filename));
@@ -385,106 +510,90 @@ ACTOR static Future<Void> _parsePartitionedLogFileOnLoader(
 	    .detail("Offset", asset.offset)
 	    .detail("Length", asset.len);
 
+	// Blocks of a file are decoded in parallel, and only added to kvOps in file order below
+	state VersionedMutationsVec decoded;
+	try {
+		VersionedMutationsVec mutations =
+		    wait(decodePartitionedLogBlock(decodeThreads, std::move(buf), asset.beginVersion, asset.endVersion));
+		decoded = mutations;
+	} catch (Error& e) {
+		TraceEvent(SevWarn, "FileRestoreCorruptLogFileBlock")
+		    .error(e)
+		    .detail("BatchIndex", asset.batchIndex)
+		    .detail("Filename", file->getFilename())
+		    .detail("BlockOffset", asset.offset)
+		    .detail("BlockLen", asset.len);
+		throw;
+	}
+	cc->decodedBlocks += 1;
+	cc->decodedBytes += asset.len;
+
 	// Ensure data blocks in the same file are processed in order
 	wait(processedFileOffset->whenAtLeast(asset.offset));
 	ASSERT(processedFileOffset->get() == asset.offset);
 
-	Arena tempArena;
-	StringRefReader reader(buf, restore_corrupted_data());
-	try {
-		// Read block header
-		if (reader.consume<int32_t>() != PARTITIONED_MLOG_VERSION)
-			throw restore_unsupported_file_version();
-
-		VersionedMutationsMap& kvOps = kvOpsIter->second;
-		while (1) {
-			// If eof reached or first key len bytes is 0xFF then end of block was reached.
-			if (reader.eof() || *reader.rptr == 0xFF)
-				break;
-
-			// Deserialize messages written in saveMutationsToFile().
-			LogMessageVersion msgVersion;
-			msgVersion.version = reader.consumeNetworkUInt64();
-			msgVersion.sub = reader.consumeNetworkUInt32();
-			int msgSize = reader.consumeNetworkInt32();
-			const uint8_t* message = reader.consume(msgSize);
-
-			// Skip mutations out of the version range
-			if (!asset.isInVersionRange(msgVersion.version))
-				continue;
-
-			VersionedMutationsMap::iterator it;
-			bool inserted;
-			std::tie(it, inserted) = kvOps.emplace(msgVersion, MutationsVec());
-			// A clear mutation can be split into multiple mutations with the same (version, sub).
-			// See saveMutationsToFile(). Current tests only use one key range per backup, thus
-			// only one clear mutation is generated (i.e., always inserted).
-			ASSERT(inserted);
-
-			ArenaReader rd(buf.arena(), StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
-			MutationRef mutation;
-			rd >> mutation;
-
-			// Skip mutation whose commitVesion < range kv's version
-			if (logMutationTooOld(pRangeVersions, mutation, msgVersion.version)) {
-				cc->oldLogMutations += 1;
-				continue;
-			}
+	VersionedMutationsMap& kvOps = kvOpsIter->second;
+	for (const VersionedMutation& vm : decoded) {
+		VersionedMutationsMap::iterator it;
+		bool inserted;
+		std::tie(it, inserted) = kvOps.emplace(vm.version, MutationsVec());
+		// A clear mutation can be split into multiple mutations with the same (version, sub).
+		// See saveMutationsToFile(). Current tests only use one key range per backup, thus
+		// only one clear mutation is generated (i.e., always inserted).
+		ASSERT(inserted);
+
+		MutationRef mutation = vm.mutation;
+
+		// Skip mutation whose commitVesion < range kv's version
+		if (logMutationTooOld(pRangeVersions, mutation, vm.version.version)) {
+			cc->oldLogMutations += 1;
+			continue;
+		}
 
-			// Should this mutation be skipped?
-			if (mutation.param1 >= asset.range.end ||
-			    (isRangeMutation(mutation) && mutation.param2 < asset.range.begin) ||
-			    (!isRangeMutation(mutation) && mutation.param1 < asset.range.begin)) {
-				continue;
-			}
+		// Should this mutation be skipped?
+		if (mutation.param1 >= asset.range.end ||
+		    (isRangeMutation(mutation) && mutation.param2 < asset.range.begin) ||
+		    (!isRangeMutation(mutation) && mutation.param1 < asset.range.begin)) {
+			continue;
+		}
 
-			// Only apply mutation within the asset.range
-			ASSERT(asset.removePrefix.size() == 0);
-			if (isRangeMutation(mutation)) {
-				mutation.param1 = mutation.param1 >= asset.range.begin ? mutation.param1 : asset.range.begin;
-				mutation.param2 = mutation.param2 < asset.range.end ? mutation.param2 : asset.range.end;
-				// Remove prefix or add prefix when we restore to a new key space
-				if (asset.hasPrefix()) { // Avoid creating new Key
-					mutation.param1 =
-					    mutation.param1.removePrefix(asset.removePrefix).withPrefix(asset.addPrefix, tempArena);
-					mutation.param2 =
-					    mutation.param2.removePrefix(asset.removePrefix).withPrefix(asset.addPrefix, tempArena);
-				}
-			} else {
-				if (asset.hasPrefix()) { // Avoid creating new Key
-					mutation.param1 =
-					    mutation.param1.removePrefix(asset.removePrefix).withPrefix(asset.addPrefix, tempArena);
-				}
+		// The decoded mutations point into the block, so keep it alive with kvOps instead of copying them
+		Arena& arena = it->second.arena();
+		arena.dependsOn(decoded.arena());
+
+		// Only apply mutation within the asset.range
+		ASSERT(asset.removePrefix.size() == 0);
+		if (isRangeMutation(mutation)) {
+			mutation.param1 = mutation.param1 >= asset.range.begin ? mutation.param1 : asset.range.begin;
+			mutation.param2 = mutation.param2 < asset.range.end ? mutation.param2 : asset.range.end;
+			// asset.range is not part of the block, so the clipped bounds must be copied
+			mutation.param1 = StringRef(arena, mutation.param1);
+			mutation.param2 = StringRef(arena, mutation.param2);
+			// Remove prefix or add prefix when we restore to a new key space
+			if (asset.hasPrefix()) { // Avoid creating new Key
+				mutation.param1 = mutation.param1.removePrefix(asset.removePrefix).withPrefix(asset.addPrefix, arena);
+				mutation.param2 = mutation.param2.removePrefix(asset.removePrefix).withPrefix(asset.addPrefix, arena);
 			}
-
-			TraceEvent(SevFRMutationInfo, "FastRestoreDecodePartitionedLogFile")
-			    .detail("CommitVersion", msgVersion.toString())
-			    .detail("ParsedMutation", mutation.toString());
-			it->second.push_back_deep(it->second.arena(), mutation);
-			cc->loadedLogBytes += mutation.totalSize();
-			// Sampling data similar to SS sample kvs
-			ByteSampleInfo sampleInfo = isKeyValueInSample(KeyValueRef(mutation.param1, mutation.param2));
-			if (sampleInfo.inSample) {
-				cc->sampledLogBytes += sampleInfo.sampledSize;
-				samplesIter->second.push_back_deep(samplesIter->second.arena(),
-				                                   SampledMutation(mutation.param1, sampleInfo.sampledSize));
+		} else {
+			if (asset.hasPrefix()) { // Avoid creating new Key
+				mutation.param1 = mutation.param1.removePrefix(asset.removePrefix).withPrefix(asset.addPrefix, arena);
 			}
 		}
 
-		// Make sure any remaining bytes in the block are 0xFF
-		for (auto b : reader.remainder()) {
-			if (b != 0xFF)
-				throw restore_corrupted_data_padding();
+		TraceEvent(SevFRMutationInfo, "FastRestoreDecodePartitionedLogFile")
+		    .detail("CommitVersion", vm.version.toString())
+		    .detail("ParsedMutation", mutation.toString());
+		it->second.push_back(arena, mutation);
+		cc->loadedLogBytes += mutation.totalSize();
+		// Sampling data similar to SS sample kvs
+		ByteSampleInfo sampleInfo = isKeyValueInSample(KeyValueRef(mutation.param1, mutation.param2));
+		if (sampleInfo.inSample) {
+			cc->sampledLogBytes += sampleInfo.sampledSize;
+			samplesIter->second.push_back_deep(samplesIter->second.arena(),
+			                                   SampledMutation(mutation.param1, sampleInfo.sampledSize));
 		}
-	} catch (Error& e) {
-		TraceEvent(SevWarn, "FileRestoreCorruptLogFileBlock")
-		    .error(e)
-		    .detail("BatchIndex", asset.batchIndex)
-		    .detail("Filename", file->getFilename())
-		    .detail("BlockOffset", asset.offset)
-		    .detail("BlockLen", asset.len);
-		throw;
 	}
+
 	processedFileOffset->set(asset.offset + asset.len);
 	return Void();
 }
@@ -497,12 +606,13 @@ ACTOR static Future<Void> parsePartitionedLogFileOnLoader(
     std::map<LoadingParam, SampledMutationsVec>::iterator samplesIter,
     LoaderCounters* cc,
     Reference<IBackupContainer> bc,
+    Reference<IThreadPool> decodeThreads,
     RestoreAsset asset) {
 	state int readFileRetries = 0;
 	loop {
 		try {
 			wait(_parsePartitionedLogFileOnLoader(
-			    pRangeVersions, processedFileOffset, kvOpsIter, samplesIter, cc, bc, asset));
+			    pRangeVersions, processedFileOffset, kvOpsIter, samplesIter, cc, bc, decodeThreads, asset));
 			break;
 		} catch (Error& e) {
 			if (e.code() == error_code_restore_bad_read || e.code() == error_code_restore_unsupported_file_version ||
@@ -529,7 +639,8 @@ ACTOR Future<Void> _processLoadingParam(KeyRangeMap<Version>* pRangeVersions,
                                         LoadingParam param,
                                         Reference<LoaderBatchData> batchData,
                                         UID loaderID,
-                                        Reference<IBackupContainer> bc) {
+                                        Reference<IBackupContainer> bc,
+                                        Reference<IThreadPool> decodeThreads) {
 	// Temporary data structure for parsing log files into (version, <K, V, mutationType>)
 	// Must use StandAlone to save mutations, otherwise, the mutationref memory will be corrupted
 	// mutationMap: Key is the unique identifier for a batch of mutation logs at the same version
@@ -558,8 +669,13 @@ ACTOR Future<Void> _processLoadingParam(KeyRangeMap<Version>* pRangeVersions,
 		subAsset.offset = j;
 		subAsset.len = std::min<int64_t>(param.blockSize, param.asset.len - j);
 		if (param.isRangeFile) {
-			fileParserFutures.push_back(_parseRangeFileToMutationsOnLoader(
-			    kvOpsPerLPIter, samplesIter, &batchData->counters, bc, param.rangeVersion.get(), subAsset));
+			fileParserFutures.push_back(_parseRangeFileToMutationsOnLoader(kvOpsPerLPIter,
+			                                                               samplesIter,
+			                                                               &batchData->counters,
+			                                                               bc,
+			                                                               decodeThreads,
+			                                                               param.rangeVersion.get(),
+			                                                               subAsset));
 		} else {
 			// TODO: Sanity check the log file's range is overlapped with the restored version range
 			if (param.isPartitionedLog()) {
@@ -569,6 +685,7 @@ ACTOR Future<Void> _processLoadingParam(KeyRangeMap<Version>* pRangeVersions,
 				                                                            samplesIter,
 				                                                            &batchData->counters,
 				                                                            bc,
+				                                                            decodeThreads,
 				                                                            subAsset));
 			} else {
 				fileParserFutures.push_back(
@@ -620,7 +737,7 @@ ACTOR Future<Void> handleLoadFileRequest(RestoreLoadFileRequest req, Reference<R
 		    .detail("ProcessLoadParam", req.param.toString());
 		ASSERT(batchData->sampleMutations.find(req.param) == batchData->sampleMutations.end());
 		batchData->processedFileParams[req.param] =
-		    _processLoadingParam(&self->rangeVersions, req.param, batchData, self->id(), self->bc);
+		    _processLoadingParam(&self->rangeVersions, req.param, batchData, self->id(), self->bc, self->decodeThreads);
 		self->inflightLoadingReqs++;
 		isDuplicated = false;
 	} else {
@@ -1192,6 +1309,7 @@ ACTOR static Future<Void> _parseRangeFileToMutationsOnLoader(
     std::map<LoadingParam, SampledMutationsVec>::iterator samplesIter,
     LoaderCounters* cc,
     Reference<IBackupContainer> bc,
+    Reference<IThreadPool> decodeThreads,
     Version version,
     RestoreAsset asset) {
 	state VersionedMutationsMap& kvOps = kvOpsIter->second;
@@ -1214,9 +1332,16 @@ ACTOR static Future<Void> _parseRangeFileToMutationsOnLoader(
 		try {
 			// The set of key value version is rangeFile.version. the key-value set in the same range file has the same
 			// version
-			Reference<IAsyncFile> inFile = wait(bc->readFile(asset.filename));
-			Standalone<VectorRef<KeyValueRef>> kvs =
-			    wait(fileBackup::decodeRangeFileBlock(inFile, asset.offset, asset.len));
+			state Reference<IAsyncFile> inFile = wait(bc->readFile(asset.filename));
+			state Standalone<StringRef> buf = makeString(asset.len);
+			int rLen = wait(inFile->read(mutateString(buf), asset.len, asset.offset));
+			if (rLen != asset.len)
+				throw restore_bad_read();
+			simulateBlobFailure();
+
+			Standalone<VectorRef<KeyValueRef>> kvs = wait(decodeRangeBlock(decodeThreads, std::move(buf)));
+			cc->decodedBlocks += 1;
+			cc->decodedBytes += asset.len;
 			TraceEvent("FastRestoreLoaderDecodedRangeFile")
 			    .detail("BatchIndex", asset.batchIndex)
 			    .detail("Filename", asset.filename)
@@ -1242,6 +1367,11 @@ ACTOR static Future<Void> _parseRangeFileToMutationsOnLoader(
 		}
 	}
 
+	// The block index of a compressed file holds no data
+	if (blockData.empty()) {
+		return Void();
+	}
+
 	// First and last key are the range for this file
 	KeyRange fileRange = KeyRangeRef(blockData.front().key, blockData.back().key);
 
@@ -1273,27 +1403,31 @@ ACTOR static Future<Void> _parseRangeFileToMutationsOnLoader(
 	// Note we give INT_MAX as the sub sequence number to override any log mutations.
 	const LogMessageVersion msgVersion(version, std::numeric_limits<int32_t>::max());
 
-	// Convert KV in data into SET mutations of different keys in kvOps
-	Arena tempArena;
+	// Convert KV in data into SET mutations of different keys in kvOps. All of them share one version, and the
+	// mutations point into the decoded block, which the version's arena keeps alive, instead of being copied.
+	if (data.empty()) {
+		return Void();
+	}
+	MutationsVec& mutations = kvOps.insert(std::make_pair(msgVersion, MutationsVec())).first->second;
+	mutations.arena().dependsOn(blockData.arena());
 	for (const KeyValueRef& kv : data) {
 		// NOTE: The KV pairs in range files are the real KV pairs in original DB.
 		MutationRef m(MutationRef::Type::SetValue, kv.key, kv.value);
 		// Remove prefix or add prefix in case we restore data to a different sub keyspace
 		if (asset.hasPrefix()) { // Avoid creating new Key
 			ASSERT(asset.removePrefix.size() == 0);
-			m.param1 = m.param1.removePrefix(asset.removePrefix).withPrefix(asset.addPrefix, tempArena);
+			m.param1 = m.param1.removePrefix(asset.removePrefix).withPrefix(asset.addPrefix, mutations.arena());
 		}
 
 		cc->loadedRangeBytes += m.totalSize();
 
 		// We cache all kv operations into kvOps, and apply all kv operations later in one place
-		auto it = kvOps.insert(std::make_pair(msgVersion, MutationsVec()));
 		TraceEvent(SevFRMutationInfo, "FastRestoreDecodeRangeFile")
 		    .detail("BatchIndex", asset.batchIndex)
 		    .detail("CommitVersion", version)
 		    .detail("ParsedMutationKV", m.toString());
 
-		it.first->second.push_back_deep(it.first->second.arena(), m);
+		mutations.push_back(mutations.arena(), m);
 		// Sampling (FASTRESTORE_SAMPLING_PERCENT%) data
 		ByteSampleInfo sampleInfo = isKeyValueInSample(KeyValueRef(m.param1, m.param2));
 		if (sampleInfo.inSample) {
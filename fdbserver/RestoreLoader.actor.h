@@ -39,6 +39,7 @@
 #include "fdbserver/RestoreCommon.actor.h"
 #include "fdbserver/RestoreRoleCommon.actor.h"
 #include "fdbclient/BackupContainer.h"
+#include "flow/IThreadPool.h"
 
 #include "flow/actorcompiler.h" // has to be last include
 
@@ -83,12 +84,14 @@ struct LoaderBatchData : public ReferenceCounted<LoaderBatchData> {
 		Counter loadedRangeBytes, loadedLogBytes, sentBytes;
 		Counter sampledRangeBytes, sampledLogBytes;
 		Counter oldLogMutations;
+		Counter decodedBlocks, decodedBytes;
 
 		Counters(LoaderBatchData* self, UID loaderInterfID, int batchIndex)
 		  : cc("LoaderBatch", loaderInterfID.toString() + ":" + std::to_string(batchIndex)),
 		    loadedRangeBytes("LoadedRangeBytes", cc), loadedLogBytes("LoadedLogBytes", cc), sentBytes("SentBytes", cc),
 		    sampledRangeBytes("SampledRangeBytes", cc), sampledLogBytes("SampledLogBytes", cc),
-		    oldLogMutations("OldLogMutations", cc) {}
+		    oldLogMutations("OldLogMutations", cc), decodedBlocks("DecodedBlocks", cc),
+		    decodedBytes("DecodedBytes", cc) {}
 	} counters;
 
 	explicit LoaderBatchData(UID nodeID, int batchIndex)
@@ -112,6 +115,9 @@ struct LoaderBatchData : public ReferenceCounted<LoaderBatchData> {
 
 using LoaderCounters = LoaderBatchData::Counters;
 
+// Threads that decode backup file blocks for a loader; null when blocks are decoded on the network thread.
+Reference<IThreadPool> createRestoreDecodeThreads();
+
 struct LoaderBatchStatus : public ReferenceCounted<LoaderBatchStatus> {
 	Optional<Future<Void>> sendAllRanges;
 	Optional<Future<Void>> sendAllLogs;
@@ -176,6 +182,8 @@ struct RestoreLoaderData : RestoreRoleData, public ReferenceCounted<RestoreLoade
 
 	Reference<AsyncVar<bool>> hasPendingRequests; // are there pending requests for loader
 
+	Reference<IThreadPool> decodeThreads; // decodes backup file blocks off the network thread, if not null
+
 	// addActor: add to actorCollection so that when an actor has error, the ActorCollection can catch the error.
 	// addActor is used to create the actorCollection when the RestoreController is created
 	PromiseStream<Future<Void>> addActor;
@@ -189,6 +197,7 @@ struct RestoreLoaderData : RestoreRoleData, public ReferenceCounted<RestoreLoade
 		nodeIndex = assignedIndex;
 		role = RestoreRole::Loader;
 		hasPendingRequests = makeReference<AsyncVar<bool>>(false);
+		decodeThreads = createRestoreDecodeThreads();
 	}
 
 	~RestoreLoaderData() override = default;
@@ -669,6 +669,28 @@ struct RolesInfo {
 	}
 };
 
+// Latencies of the busiest message types at one process, from its latest EndpointLatencyMetrics event
+static JsonBuilderArray getEndpointLatencies(TraceEventFields const& event) {
+	JsonBuilderArray latencies;
+	int messageTypes = event.getInt("MessageTypes");
+	for (int i = 0; i < messageTypes; ++i) {
+		std::string prefix = format("MessageType%d", i);
+		auto getLatency = [&](std::string const& kind) {
+			JsonBuilderObject latency;
+			latency.setKeyRawNumber("count", event.getValue(prefix + kind + "Count"));
+			latency.setKeyRawNumber("median", event.getValue(prefix + kind + "Median"));
+			latency.setKeyRawNumber("p99", event.getValue(prefix + kind + "P99"));
+			return latency;
+		};
+		JsonBuilderObject messageType;
+		messageType["message_type"] = event.getValue(prefix);
+		messageType["queue_latency"] = getLatency("Queue");
+		messageType["service_latency"] = getLatency("Service");
+		latencies.push_back(messageType);
+	}
+	return latencies;
+}
+
 ACTOR static Future<JsonBuilderObject> processStatusFetcher(
     Reference<AsyncVar<ServerDBInfo>> db,
     std::vector<WorkerDetails> workers,
@@ -678,6 +700,7 @@ ACTOR static Future<JsonBuilderObject> processStatusFetcher(
     WorkerEvents errors,
     WorkerEvents traceFileOpenErrors,
     WorkerEvents programStarts,
+    WorkerEvents endpointLatencies,
     std::map<std::string, std::vector<JsonBuilderObject>> processIssues,
     vector<std::pair<StorageServerInterface, EventMap>> storageServers,
     vector<std::pair<TLogInterface, EventMap>> tLogs,
@@ -987,6 +1010,10 @@ ACTOR static Future<JsonBuilderObject> processStatusFetcher(
 				statusObj["degraded"] = true;
 			}
 
+			if (endpointLatencies.count(address) && endpointLatencies[address].size()) {
+				statusObj["endpoint_latencies"] = getEndpointLatencies(endpointLatencies[address]);
+			}
+
 			const TraceEventFields& networkMetrics = nMetrics[workerItr->interf.address()];
 			double networkMetricsElapsed = networkMetrics.getDouble("Elapsed");
 
@@ -1645,6 +1672,8 @@ ACTOR static Future<JsonBuilderObject> dataStatusFetcher(WorkerDetails ddWorker,
 			statusObjData.setKeyRawNumber("total_kv_size_bytes", dataStats.getValue("TotalSizeBytes"));
 			statusObjData.setKeyRawNumber("system_kv_size_bytes", dataStats.getValue("SystemSizeBytes"));
 			statusObjData.setKeyRawNumber("partitions_count", dataStats.getValue("Shards"));
+			statusObjData.setKeyRawNumber("partitions_coalesced", dataStats.getValue("CoalescedShards"));
+			statusObjData.setKeyRawNumber("partitions_coalesced_hz", dataStats.getValue("CoalescedShardsHz"));
 		}
 
 		JsonBuilderArray teamTrackers;
@@ -2059,6 +2088,15 @@ ACTOR static Future<JsonBuilderObject> workloadStatusFetcher(
 			    getLagObject(ratekeeper.getInt64("WorstStorageServerDurabilityLag"));
 			(*qos)["limiting_durability_lag_storage_server"] =
 			    getLagObject(ratekeeper.getInt64("LimitingStorageServerDurabilityLag"));
+
+			JsonBuilderObject writePressureObj;
+			writePressureObj.setKeyRawNumber("count", ratekeeper.getValue("LocallyThrottledStorageServers"));
+			writePressureObj.setKeyRawNumber("worst_pressure", ratekeeper.getValue("WorstStorageWritePressure"));
+			std::string worstPressureId = ratekeeper.getValue("WorstStorageWritePressureServerID");
+			if (!worstPressureId.empty()) {
+				writePressureObj["worst_pressure_storage_server"] = worstPressureId;
+			}
+			(*qos)["locally_throttled_storage_servers"] = writePressureObj;
 		}
 
 		if (tlogCount > 0) {
@@ -2698,6 +2736,7 @@ ACTOR Future<StatusReply> clusterGetStatus(
 		futures.push_back(latestErrorOnWorkers(workers)); // Get all latest errors.
 		futures.push_back(latestEventOnWorkers(workers, "TraceFileOpenError"));
 		futures.push_back(latestEventOnWorkers(workers, "ProgramStart"));
+		futures.push_back(latestEventOnWorkers(workers, "EndpointLatencyMetrics"));
 
 		// Wait for all response pairs.
 		state std::vector<Optional<std::pair<WorkerEvents, std::set<std::string>>>> workerEventsVec =
@@ -2743,6 +2782,8 @@ ACTOR Future<StatusReply> clusterGetStatus(
 		    workerEventsVec[4].present() ? workerEventsVec[4].get().first : WorkerEvents();
 		state WorkerEvents programStarts =
 		    workerEventsVec[5].present() ? workerEventsVec[5].get().first : WorkerEvents();
+		state WorkerEvents endpointLatencies =
+		    workerEventsVec[6].present() ? workerEventsVec[6].get().first : WorkerEvents();
 
 		state JsonBuilderObject statusObj;
 		if (db->get().recoveryCount > 0) {
@@ -2953,6 +2994,7 @@ ACTOR Future<StatusReply> clusterGetStatus(
 		                              latestError,
 		                              traceFileOpenErrors,
 		                              programStarts,
+		                              endpointLatencies,
 		                              processIssues,
 		                              storageServers,
 		                              tLogs,
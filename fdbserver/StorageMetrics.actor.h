@@ -187,6 +187,114 @@ private:
 	}
 };
 
+// A space-saving sketch of the costliest transaction tags. It keeps at most `capacity` counters however many tags
+// clients use. Any tag whose cost is more than total() / capacity is guaranteed to have a counter, and a counter's
+// cost overestimates the tag's true cost by at most its error.
+struct TagCostSketch {
+	struct Entry {
+		TransactionTag tag;
+		int64_t cost;
+		int64_t error;
+
+		Entry(TransactionTag const& tag, int64_t cost, int64_t error) : tag(tag), cost(cost), error(error) {}
+
+		// The cost this tag is known to have incurred
+		int64_t guaranteedCost() const { return cost - error; }
+	};
+
+	explicit TagCostSketch(int capacity) : capacity(std::max(capacity, 1)), totalCost(0) {}
+
+	void add(TransactionTag const& tag, int64_t cost) {
+		totalCost += cost;
+		auto it = index.find(tag);
+		if (it != index.end()) {
+			entries[it->second].cost += cost;
+			return;
+		}
+		if (entries.size() < capacity) {
+			index[tag] = entries.size();
+			entries.emplace_back(tag, cost, 0);
+			return;
+		}
+		// Evict the cheapest tag; the new tag may have incurred up to its cost while untracked.
+		int minIdx = 0;
+		for (int i = 1; i < entries.size(); i++) {
+			if (entries[i].cost < entries[minIdx].cost) {
+				minIdx = i;
+			}
+		}
+		Entry& e = entries[minIdx];
+		index.erase(e.tag);
+		index[tag] = minIdx;
+		e = Entry(tag, e.cost + cost, e.cost);
+	}
+
+	// Returns up to k of the tags with the highest cost, costliest first
+	std::vector<Entry> topK(int k) const {
+		std::vector<Entry> result = entries;
+		std::sort(result.begin(), result.end(), [](Entry const& a, Entry const& b) { return a.cost > b.cost; });
+		if (result.size() > std::max(k, 0)) {
+			result.erase(result.begin() + std::max(k, 0), result.end());
+		}
+		return result;
+	}
+
+	int64_t total() const { return totalCost; }
+	int size() const { return entries.size(); }
+
+	void clear() {
+		entries.clear();
+		index.clear();
+		totalCost = 0;
+	}
+
+private:
+	int capacity;
+	int64_t totalCost;
+	std::vector<Entry> entries;
+	TransactionTagMap<int> index;
+};
+
+TEST_CASE("/fdbserver/StorageMetricSample/tagCostSketch") {
+	TagCostSketch sketch(4);
+	std::map<TransactionTag, int64_t> trueCosts;
+	int64_t total = 0;
+	for (int i = 0; i < 10000; i++) {
+		// A few heavy tags and many light ones
+		int t = deterministicRandom()->random01() < 0.6 ? deterministicRandom()->randomInt(0, 3)
+		                                                : deterministicRandom()->randomInt(3, 1000);
+		TransactionTag tag = StringRef(format("tag%d", t));
+		int64_t cost = deterministicRandom()->randomInt(1, 10);
+		sketch.add(tag, cost);
+		trueCosts[tag] += cost;
+		total += cost;
+	}
+
+	ASSERT(sketch.total() == total);
+	ASSERT(sketch.size() == 4);
+
+	auto top = sketch.topK(3);
+	ASSERT(top.size() == 3);
+	for (int i = 0; i < top.size(); i++) {
+		ASSERT(i == 0 || top[i - 1].cost >= top[i].cost);
+		int64_t trueCost = trueCosts[top[i].tag];
+		ASSERT(top[i].guaranteedCost() <= trueCost && trueCost <= top[i].cost);
+	}
+
+	// Every tag costing more than total / capacity must be tracked
+	for (const auto& [tag, cost] : trueCosts) {
+		if (cost > total / 4) {
+			auto all = sketch.topK(4);
+			ASSERT(std::any_of(all.begin(), all.end(), [&](auto const& e) { return e.tag == tag; }));
+		}
+	}
+
+	sketch.clear();
+	ASSERT(sketch.size() == 0 && sketch.total() == 0 && sketch.topK(1).empty());
+
+	return Void();
+}
+
 struct StorageServerMetrics {
 	KeyRangeMap<vector<PromiseStream<StorageMetrics>>> waitMetricsMap;
 	StorageMetricSample byteSample;
@@ -3217,6 +3217,11 @@ public:
 	bool supportsMutation(int op) const override { NOT_IMPLEMENTED; }
 	StorageBytes getStorageBytes() const override { return m_pager->getStorageBytes(); }
 
+	// Flags describing how the owner of the tree encodes its contents.  They are kept in the meta key, so a change
+	// becomes durable with the next commit, atomically with the btree changes that depend on it.
+	uint8_t getStoreFlags() const { return m_storeFlags; }
+	void setStoreFlags(uint8_t flags) { m_storeFlags = flags; }
+
 	// Writes are provided in an ordered stream.
 	// A write is considered part of (a change leading to) the version determined by the previous call to
 	// setWriteVersion() A write shall not become durable until the following call to commit() begins, and shall be
@@ -3247,6 +3252,11 @@ public:
 		m_pBuffer->erase(iBegin, iEnd);
 	}
 
+	// Hints that the writes for the current version include sorted bulk inserts into the empty key range given.  The
+	// next commit builds an empty tree bottom-up straight from the mutation buffer, and otherwise rebuilds the leaves
+	// that overlap a hinted range rather than inserting into them one record at a time.
+	void hintBulkLoad(KeyRangeRef range) { m_bulkRanges.push_back_deep(m_bulkRanges.arena(), range); }
+
 	void mutate(int op, StringRef param1, StringRef param2) override { NOT_IMPLEMENTED; }
 
 	void setOldestVersion(Version v) override { m_newOldestVersion = v; }
@@ -3381,8 +3391,9 @@ public:
 			LogicalPageID id = wait(self->m_pager->newPageID());
 			BTreePageIDRef newRoot((LogicalPageID*)&id, 1);
 			debug_printf("new root %s\n", toString(newRoot).c_str());
-			self->m_header.root.set(newRoot, sizeof(headerSpace) - sizeof(m_header));
+			self->m_header.root.set(newRoot, sizeof(headerSpace) - sizeof(m_header) - sizeof(m_storeFlags));
 			self->m_header.height = 1;
+			self->m_storeFlags = 0;
 			++latest;
 			Reference<IPage> page = self->m_pager->newPageBuffer();
 			makeEmptyRoot(page);
@@ -3392,11 +3403,12 @@ public:
 			LogicalPageID newQueuePage = wait(self->m_pager->newPageID());
 			self->m_lazyClearQueue.create(self->m_pager, newQueuePage, "LazyClearQueue");
 			self->m_header.lazyDeleteQueue = self->m_lazyClearQueue.getState();
-			self->m_pager->setMetaKey(self->m_header.asKeyRef());
+			self->m_pager->setMetaKey(self->metaKeyWithStoreFlags());
 			wait(self->m_pager->commit());
 			debug_printf("Committed initial commit.\n");
 		} else {
 			self->m_header.fromKeyRef(meta);
+			self->m_storeFlags = self->storeFlagsFromMetaKey(meta);
 			self->m_lazyClearQueue.recover(self->m_pager, self->m_header.lazyDeleteQueue, "LazyClearQueueRecovered");
 		}
 
@@ -3728,10 +3740,54 @@ private:
 		MetaKey m_header;
 	};
 
+	// Not part of MetaKey, whose layout is fixed by FORMAT_VERSION.  The flags are written as one byte following the
+	// meta key, so a header from before they existed reads as having none set.
+	uint8_t m_storeFlags;
+
+	KeyRef metaKeyWithStoreFlags() {
+		int size = m_header.asKeyRef().size();
+		ASSERT(size < sizeof(headerSpace));
+		headerSpace[size] = m_storeFlags;
+		return KeyRef(headerSpace, size + 1);
+	}
+
+	uint8_t storeFlagsFromMetaKey(KeyRef meta) const {
+		int size = m_header.asKeyRef().size();
+		return meta.size() > size ? meta[size] : 0;
+	}
+
 	LazyClearQueueT m_lazyClearQueue;
 	Future<int> m_lazyClearActor;
 	bool m_lazyClearStop;
 
+	// Ranges passed to hintBulkLoad() for the mutation buffer being written, and for the duration of the commit of that
+	// buffer.  The latter are sorted and do not overlap.
+	Standalone<VectorRef<KeyRangeRef>> m_bulkRanges;
+	Standalone<VectorRef<KeyRangeRef>> m_commitBulkRanges;
+
+	// Sorts ranges and merges the ones that overlap or touch
+	static Standalone<VectorRef<KeyRangeRef>> coalesceRanges(Standalone<VectorRef<KeyRangeRef>> ranges) {
+		std::sort(ranges.begin(), ranges.end(), KeyRangeRef::ArbitraryOrder());
+		Standalone<VectorRef<KeyRangeRef>> merged;
+		merged.arena().dependsOn(ranges.arena());
+		for (auto const& r : ranges) {
+			if (!merged.empty() && r.begin <= merged.back().end) {
+				merged.back() = KeyRangeRef(merged.back().begin, std::max(merged.back().end, r.end));
+			} else {
+				merged.push_back(merged.arena(), r);
+			}
+		}
+		return merged;
+	}
+
+	// Whether [begin, end) overlaps a range hinted as a bulk load for the commit in progress
+	bool inBulkRange(KeyRef begin, KeyRef end) const {
+		auto const& ranges = m_commitBulkRanges;
+		auto i = std::upper_bound(
+		    ranges.begin(), ranges.end(), begin, [](KeyRef const& k, KeyRangeRef const& r) { return k < r.end; });
+		return i != ranges.end() && i->begin < end;
+	}
+
 	// Writes entries to 1 or more pages and return a vector of boundary keys with their IPage(s)
 	ACTOR static Future<Standalone<VectorRef<RedwoodRecordRef>>> writePages(VersionedBTree* self,
 	                                                                        const RedwoodRecordRef* lowerBound,
@@ -3746,7 +3802,10 @@ private:
 		// This is how much space for the binary tree exists in the page, after the header
 		state int blockSize = self->m_blockSize;
 		state int pageSize = blockSize - sizeof(BTreePage);
-		state int pageFillTarget = pageSize * SERVER_KNOBS->REDWOOD_PAGE_REBUILD_FILL_FACTOR;
+		state double fillFactor = self->inBulkRange(lowerBound->key, upperBound->key)
+		                              ? SERVER_KNOBS->REDWOOD_BULK_BUILD_FILL_FACTOR
+		                              : SERVER_KNOBS->REDWOOD_PAGE_REBUILD_FILL_FACTOR;
+		state int pageFillTarget = pageSize * fillFactor;
 		state int blockCount = 1;
 
 		state int kvBytes = 0;
@@ -3824,7 +3883,7 @@ private:
 
 					blockCount += newBlocks;
 					pageSize = newPageSize;
-					pageFillTarget = pageSize * SERVER_KNOBS->REDWOOD_PAGE_REBUILD_FILL_FACTOR;
+					pageFillTarget = pageSize * fillFactor;
 				}
 
 				kvBytes += entry.kvBytes();
@@ -4492,7 +4551,10 @@ private:
 		// TODO:  Decide if it is okay to update if the subtree boundaries are expanded.  It can result in
 		// records in a DeltaTree being outside its decode boundary range, which isn't actually invalid
 		// though it is awkward to reason about.
-		state bool tryToUpdate = btPage->tree().numItems > 0 && update->boundariesNormal();
+		// Bulk loads insert long sorted runs, which rarely fit in place, so their leaves go straight to a rebuild.
+		state bool tryToUpdate =
+		    btPage->tree().numItems > 0 && update->boundariesNormal() &&
+		    !(isLeaf && self->inBulkRange(update->subtreeLowerBound->key, update->subtreeUpperBound->key));
 
 		// If trying to update the page, we need to clone it so we don't modify the original.
 		// TODO: Refactor DeltaTree::Mirror so it can be shared between different versions of pages
@@ -5115,8 +5177,46 @@ private:
 		}
 	}
 
+	// Builds the leaf level of an empty tree straight from the sets in the mutation buffer, which are already sorted,
+	// without reading or merging with any existing page.  Clears have nothing to remove so they are skipped.
+	ACTOR static Future<Void> bulkBuild(VersionedBTree* self,
+	                                    MutationBuffer::const_iterator mBegin,
+	                                    MutationBuffer::const_iterator mEnd,
+	                                    BTreePageIDRef rootID,
+	                                    InternalPageSliceUpdate* update) {
+		state Standalone<VectorRef<RedwoodRecordRef>> records;
+		while (mBegin != mEnd) {
+			if (mBegin.mutation().boundarySet()) {
+				records.push_back(records.arena(),
+				                  RedwoodRecordRef(mBegin.key(), 0, mBegin.mutation().boundaryValue.get()));
+			}
+			++mBegin;
+		}
+
+		debug_printf("bulkBuild(root=%s): %d records\n", toString(rootID).c_str(), records.size());
+		if (records.empty()) {
+			update->childrenChanged = false;
+			return Void();
+		}
+
+		Standalone<VectorRef<RedwoodRecordRef>> entries = wait(writePages(self,
+		                                                                  update->subtreeLowerBound,
+		                                                                  update->subtreeUpperBound,
+		                                                                  records,
+		                                                                  1,
+		                                                                  self->getLastCommittedVersion() + 1,
+		                                                                  rootID));
+		update->rebuilt(entries);
+		return Void();
+	}
+
 	ACTOR static Future<Void> commit_impl(VersionedBTree* self) {
 		state MutationBuffer* mutations = self->m_pBuffer;
+		state Standalone<VectorRef<KeyRangeRef>> bulkRanges;
+		if (SERVER_KNOBS->REDWOOD_BULK_BUILD) {
+			bulkRanges = coalesceRanges(self->m_bulkRanges);
+		}
+		self->m_bulkRanges = Standalone<VectorRef<KeyRangeRef>>();
 
 		// No more mutations are allowed to be written to this mutation buffer we will commit
 		// at m_writeVersion, which we must save locally because it could change during commit.
@@ -5134,6 +5234,7 @@ private:
 		// Wait for the latest commit to be finished.
 		wait(previousCommit);
 
+		self->m_commitBulkRanges = bulkRanges;
 		self->m_pager->setOldestVersion(self->m_newOldestVersion);
 		debug_printf("%s: Beginning commit of version %" PRId64 ", new oldest version set to %" PRId64 "\n",
 		             self->m_name.c_str(),
@@ -5153,18 +5254,31 @@ private:
 		all.decodeUpperBound = &dbEnd;
 		all.skipLen = 0;
 
-		MutationBuffer::const_iterator mBegin = mutations->upper_bound(all.subtreeLowerBound->key);
+		state MutationBuffer::const_iterator mBegin = mutations->upper_bound(all.subtreeLowerBound->key);
 		--mBegin;
-		MutationBuffer::const_iterator mEnd = mutations->lower_bound(all.subtreeUpperBound->key);
+		state MutationBuffer::const_iterator mEnd = mutations->lower_bound(all.subtreeUpperBound->key);
 
-		wait(commitSubtree(self,
-		                   self->m_pager->getReadSnapshot(latestVersion),
-		                   mutations,
-		                   rootPageID,
-		                   self->m_header.height == 1,
-		                   mBegin,
-		                   mEnd,
-		                   &all));
+		// A bulk load into an empty tree builds it bottom-up, which costs one read of the empty root page.
+		state bool emptyTree = false;
+		if (!bulkRanges.empty() && self->m_header.height == 1) {
+			Reference<const IPage> root =
+			    wait(readPage(self->m_pager->getReadSnapshot(latestVersion), rootPageID, &rootLink, &dbEnd));
+			emptyTree = ((const BTreePage*)root->begin())->tree().numItems == 0;
+		}
+
+		if (emptyTree) {
+			TEST(true); // Redwood bulk built an empty tree
+			wait(bulkBuild(self, mBegin, mEnd, rootPageID, &all));
+		} else {
+			wait(commitSubtree(self,
+			                   self->m_pager->getReadSnapshot(latestVersion),
+			                   mutations,
+			                   rootPageID,
+			                   self->m_header.height == 1,
+			                   mBegin,
+			                   mEnd,
+			                   &all));
+		}
 
 		// If the old root was deleted, write a new empty tree root node and free the old roots
 		if (all.childrenChanged) {
@@ -5189,7 +5303,7 @@ private:
 			}
 		}
 
-		self->m_header.root.set(rootPageID, sizeof(headerSpace) - sizeof(m_header));
+		self->m_header.root.set(rootPageID, sizeof(headerSpace) - sizeof(m_header) - sizeof(m_storeFlags));
 
 		self->m_lazyClearStop = true;
 		wait(success(self->m_lazyClearActor));
@@ -5201,7 +5315,7 @@ private:
 		self->m_header.lazyDeleteQueue = self->m_lazyClearQueue.getState();
 
 		debug_printf("Setting metakey\n");
-		self->m_pager->setMetaKey(self->m_header.asKeyRef());
+		self->m_pager->setMetaKey(self->metaKeyWithStoreFlags());
 
 		debug_printf("%s: Committing pager %" PRId64 "\n", self->m_name.c_str(), writeVersion);
 		wait(self->m_pager->commit());
@@ -5213,6 +5327,7 @@ private:
 		self->m_mutationBuffers.erase(self->m_mutationBuffers.begin());
 
 		self->m_lastCommittedVersion = writeVersion;
+		self->m_commitBulkRanges = Standalone<VectorRef<KeyRangeRef>>();
 		++g_redwoodMetrics.opCommit;
 		self->m_lazyClearActor = incrementalLazyClear(self);
 
@@ -5946,10 +6061,63 @@ public:
 RedwoodRecordRef VersionedBTree::dbBegin(LiteralStringRef(""));
 RedwoodRecordRef VersionedBTree::dbEnd(LiteralStringRef("\xff\xff\xff\xff\xff"));
 
+// Large values can be kept out of the btree in an append-only value log made of segment files named
+// <filePrefix>.<segment>.vlog.  A segment is a sequence of records, each a ValueLogRecordHeader followed by the key and
+// the value, and the btree stores a ValueLogPointer in place of the value so that rewriting a leaf page no longer
+// rewrites the large values stored in it.
+#pragma pack(push, 1)
+struct ValueLogRecordHeader {
+	uint32_t keyLength;
+	uint32_t valueLength;
+};
+
+struct ValueLogPointer {
+	uint32_t segment;
+	int64_t offset; // Of the value bytes within the segment
+	uint32_t length;
+	uint32_t checksum; // crc32c of the value bytes
+};
+#pragma pack(pop)
+
+// When a store uses the value log, every value in its btree starts with one of these
+enum class ValueLogTag : uint8_t { Inline = 0, Logged = 1 };
+
+// Bits of the btree's store flags used by KeyValueStoreRedwoodUnversioned
+enum RedwoodStoreFlags : uint8_t { STORE_FLAG_VALUE_LOG = 1 };
+
+struct RedwoodValueLogOptions {
+	// Values of at least this many bytes are logged; a new store only uses the value log if this is positive
+	int threshold = SERVER_KNOBS->REDWOOD_VALUE_LOG_THRESHOLD;
+	int64_t segmentBytes = SERVER_KNOBS->REDWOOD_VALUE_LOG_SEGMENT_BYTES;
+	int64_t gcMinBytes = SERVER_KNOBS->REDWOOD_VALUE_LOG_GC_MIN_BYTES;
+	int64_t gcBytesPerCommit = SERVER_KNOBS->REDWOOD_VALUE_LOG_GC_BYTES_PER_COMMIT;
+};
+
 class KeyValueStoreRedwoodUnversioned : public IKeyValueStore {
+	struct ValueLogSegment {
+		Reference<IAsyncFile> file;
+		int64_t size;
+	};
+
+	// Versions of the reads in progress, which may still follow pointers into a segment that has been collected
+	struct ActiveReads : ReferenceCounted<ActiveReads> {
+		std::multiset<Version> versions;
+	};
+
+	struct ActiveRead {
+		Reference<ActiveReads> reads;
+		std::multiset<Version>::iterator it;
+
+		ActiveRead(Reference<ActiveReads> reads, Version v) : reads(reads), it(reads->versions.insert(v)) {}
+		~ActiveRead() { reads->versions.erase(it); }
+	};
+
 public:
-	KeyValueStoreRedwoodUnversioned(std::string filePrefix, UID logID)
-	  : m_filePrefix(filePrefix), m_concurrentReads(new FlowLock(SERVER_KNOBS->REDWOOD_KVSTORE_CONCURRENT_READS)) {
+	KeyValueStoreRedwoodUnversioned(std::string filePrefix,
+	                                UID logID,
+	                                RedwoodValueLogOptions valueLogOptions = RedwoodValueLogOptions())
+	  : m_filePrefix(filePrefix), m_concurrentReads(new FlowLock(SERVER_KNOBS->REDWOOD_KVSTORE_CONCURRENT_READS)),
+	    m_valueLogOptions(valueLogOptions), m_newStore(!fileExists(filePrefix)), m_activeReads(new ActiveReads()) {
 		// TODO: This constructor should really just take an IVersionedStore
 
 		int pageSize =
@@ -5972,24 +6140,108 @@ public:
 	ACTOR Future<Void> init_impl(KeyValueStoreRedwoodUnversioned* self) {
 		TraceEvent(SevInfo, "RedwoodInit").detail("FilePrefix", self->m_filePrefix);
 		wait(self->m_tree->init());
+		wait(openValueLog(self));
 		Version v = self->m_tree->getLatestVersion();
 		self->m_tree->setWriteVersion(v + 1);
-		TraceEvent(SevInfo, "RedwoodInitComplete").detail("FilePrefix", self->m_filePrefix);
+		TraceEvent(SevInfo, "RedwoodInitComplete")
+		    .detail("FilePrefix", self->m_filePrefix)
+		    .detail("ValueLog", self->m_valueLogEnabled);
+		return Void();
+	}
+
+	static std::string valueLogSegmentName(std::string const& filePrefix, uint32_t segment) {
+		return format("%s.%06u.vlog", filePrefix.c_str(), segment);
+	}
+
+	static std::vector<uint32_t> listValueLogSegments(std::string const& filePrefix) {
+		std::vector<uint32_t> segments;
+		std::string prefix = basename(filePrefix) + ".";
+		for (auto const& f : platform::listFiles(parentDirectory(filePrefix), ".vlog")) {
+			unsigned int segment;
+			if (StringRef(f).startsWith(StringRef(prefix)) &&
+			    sscanf(f.c_str() + prefix.size(), "%u.vlog", &segment) == 1) {
+				segments.push_back(segment);
+			}
+		}
+		std::sort(segments.begin(), segments.end());
+		return segments;
+	}
+
+	// Whether a store uses the value log is recorded in the btree's store flags when the store is created, so whether
+	// its values are tagged never changes over the life of the store, however many segment files it has.  The head
+	// segment is only created by the first commit that logs a value to it.
+	ACTOR static Future<Void> openValueLog(KeyValueStoreRedwoodUnversioned* self) {
+		state std::vector<uint32_t> segments = listValueLogSegments(self->m_filePrefix);
+		state int i;
+		state Reference<IAsyncFile> file;
+		if (!(self->m_tree->getStoreFlags() & STORE_FLAG_VALUE_LOG)) {
+			// Segments written ahead of a first commit that never became durable, which nothing can refer to
+			for (i = 0; i < segments.size(); ++i) {
+				wait(IAsyncFileSystem::filesystem()->deleteFile(valueLogSegmentName(self->m_filePrefix, segments[i]),
+				                                                true));
+			}
+			if (!self->m_newStore || self->m_valueLogOptions.threshold <= 0) {
+				return Void();
+			}
+			// Made durable by the first commit, which is also the first that can store tagged values
+			self->m_tree->setStoreFlags(self->m_tree->getStoreFlags() | STORE_FLAG_VALUE_LOG);
+			segments.clear();
+		}
+
+		for (i = 0; i < segments.size(); ++i) {
+			wait(store(file,
+			           IAsyncFileSystem::filesystem()->open(
+			               valueLogSegmentName(self->m_filePrefix, segments[i]),
+			               IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_LOCK,
+			               0644)));
+			int64_t size = wait(file->size());
+			self->m_valueLogSegments[segments[i]] = ValueLogSegment{ file, size };
+		}
+		// The last segment may end in a partial record from before a restart, so start a new one
+		self->m_valueLogHead = segments.empty() ? 0 : segments.back() + 1;
+		self->m_gcSegment = segments.empty() ? 0 : segments.front();
+		self->m_valueLogEnabled = true;
+		return Void();
+	}
+
+	ACTOR static Future<Void> openHeadSegment(KeyValueStoreRedwoodUnversioned* self) {
+		state uint32_t segment = self->m_valueLogHead;
+		if (!self->m_valueLogSegments.count(segment)) {
+			Reference<IAsyncFile> file = wait(IAsyncFileSystem::filesystem()->open(
+			    valueLogSegmentName(self->m_filePrefix, segment),
+			    IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_LOCK |
+			        IAsyncFile::OPEN_CREATE | IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE,
+			    0644));
+			self->m_valueLogSegments[segment] = ValueLogSegment{ file, 0 };
+		}
 		return Void();
 	}
 
 	ACTOR void shutdown(KeyValueStoreRedwoodUnversioned* self, bool dispose) {
 		TraceEvent(SevInfo, "RedwoodShutdown").detail("FilePrefix", self->m_filePrefix).detail("Dispose", dispose);
+		state std::vector<std::string> segmentNames;
+		state int i;
 		if (self->m_error.canBeSet()) {
 			self->m_error.sendError(actor_cancelled()); // Ideally this should be shutdown_in_progress
 		}
 		self->m_init.cancel();
+		// The value log commit owns the buffers of its writes, so let it finish rather than cancel it
+		wait(ready(self->m_valueLogCommit));
 		Future<Void> closedFuture = self->m_tree->onClosed();
 		if (dispose)
 			self->m_tree->dispose();
 		else
 			self->m_tree->close();
 		wait(closedFuture);
+		for (auto const& s : self->m_valueLogSegments) {
+			segmentNames.push_back(valueLogSegmentName(self->m_filePrefix, s.first));
+		}
+		self->m_valueLogSegments.clear();
+		if (dispose) {
+			for (i = 0; i < segmentNames.size(); ++i) {
+				wait(IAsyncFileSystem::filesystem()->deleteFile(segmentNames[i], true));
+			}
+		}
 		self->m_closed.send(Void());
 		TraceEvent(SevInfo, "RedwoodShutdownComplete")
 		    .detail("FilePrefix", self->m_filePrefix)
@@ -6004,28 +6256,328 @@ public:
 	Future<Void> onClosed() override { return m_closed.getFuture(); }
 
 	Future<Void> commit(bool sequential = false) override {
+		if (m_valueLogEnabled) {
+			Standalone<VectorRef<MutationRef>> mutations = m_stagedMutations;
+			Standalone<VectorRef<KeyRangeRef>> bulkRanges = m_stagedBulkRanges;
+			m_stagedMutations = Standalone<VectorRef<MutationRef>>();
+			m_stagedBulkRanges = Standalone<VectorRef<KeyRangeRef>>();
+			m_valueLogCommit = commitWithValueLog(this, mutations, bulkRanges, m_valueLogCommit);
+			return catchError(m_valueLogCommit);
+		}
 		Future<Void> c = m_tree->commit();
 		m_tree->setOldestVersion(m_tree->getLatestVersion());
 		m_tree->setWriteVersion(m_tree->getWriteVersion() + 1);
 		return catchError(c);
 	}
 
+	static ValueLogPointer getValueLogPointer(ValueRef stored) {
+		ValueLogPointer p;
+		ASSERT(stored.size() == 1 + sizeof(p));
+		memcpy(&p, stored.begin() + 1, sizeof(p));
+		return p;
+	}
+
+	static bool isLogged(ValueRef stored) { return stored.size() > 0 && stored[0] == (uint8_t)ValueLogTag::Logged; }
+
+	bool shouldLog(ValueRef value) const {
+		return m_valueLogOptions.threshold > 0 && value.size() >= m_valueLogOptions.threshold;
+	}
+
+	// Size of the value that a value stored in the btree stands for
+	int logicalValueSize(ValueRef stored) const {
+		if (!m_valueLogEnabled) {
+			return stored.size();
+		}
+		return isLogged(stored) ? getValueLogPointer(stored).length : stored.size() - 1;
+	}
+
+	// Value log writes are made durable before the btree commit that refers to them, so mutations are staged here and
+	// applied to the btree by commitWithValueLog() once their logged values are on disk.  Reads are at the last
+	// committed version, so staging does not change what readers see.
+	ACTOR static Future<Void> commitWithValueLog(KeyValueStoreRedwoodUnversioned* self,
+	                                             Standalone<VectorRef<MutationRef>> mutations,
+	                                             Standalone<VectorRef<KeyRangeRef>> bulkRanges,
+	                                             Future<Void> previousCommit) {
+		state Standalone<VectorRef<KeyValueRef>> relocated;
+		state Arena arena;
+		state VectorRef<MutationRef> treeMutations;
+		state uint8_t* batch = nullptr;
+		state int64_t batchBytes = 0;
+		state int64_t batchOffset;
+		state Optional<uint32_t> collected;
+		state ValueLogSegment* head = nullptr;
+
+		wait(previousCommit);
+
+		// Values still referenced from the segment being collected are logged again ahead of this commit's own
+		// mutations, so a key that this commit also writes ends up with the newer value
+		wait(store(collected, collectValueLogGarbage(self, &relocated)));
+
+		if (self->m_valueLogHeadSize >= self->m_valueLogOptions.segmentBytes) {
+			++self->m_valueLogHead;
+			self->m_valueLogHeadSize = 0;
+		}
+		batchOffset = self->m_valueLogHeadSize;
+
+		for (auto const& kv : relocated) {
+			batchBytes += sizeof(ValueLogRecordHeader) + kv.key.size() + kv.value.size();
+		}
+		for (auto const& m : mutations) {
+			if (m.type == MutationRef::SetValue && self->shouldLog(m.param2)) {
+				batchBytes += sizeof(ValueLogRecordHeader) + m.param1.size() + m.param2.size();
+			}
+		}
+		batch = new (arena) uint8_t[batchBytes];
+		treeMutations.reserve(arena, relocated.size() + mutations.size());
+
+		int64_t written = 0;
+		auto logValue = [&](KeyRef key, ValueRef value) {
+			ValueLogRecordHeader header{ (uint32_t)key.size(), (uint32_t)value.size() };
+			memcpy(batch + written, &header, sizeof(header));
+			memcpy(batch + written + sizeof(header), key.begin(), key.size());
+			memcpy(batch + written + sizeof(header) + key.size(), value.begin(), value.size());
+			ValueLogPointer p{ self->m_valueLogHead,
+				               batchOffset + written + (int64_t)sizeof(header) + key.size(),
+				               (uint32_t)value.size(),
+				               crc32c_append(0, value.begin(), value.size()) };
+			written += sizeof(header) + key.size() + value.size();
+
+			StringRef stored = makeString(1 + sizeof(p), arena);
+			mutateString(stored)[0] = (uint8_t)ValueLogTag::Logged;
+			memcpy(mutateString(stored) + 1, &p, sizeof(p));
+			treeMutations.push_back(arena, MutationRef(MutationRef::SetValue, key, stored));
+		};
+
+		for (auto const& kv : relocated) {
+			logValue(kv.key, kv.value);
+		}
+		for (auto const& m : mutations) {
+			if (m.type != MutationRef::SetValue) {
+				treeMutations.push_back(arena, m);
+			} else if (self->shouldLog(m.param2)) {
+				logValue(m.param1, m.param2);
+			} else {
+				StringRef stored = makeString(1 + m.param2.size(), arena);
+				mutateString(stored)[0] = (uint8_t)ValueLogTag::Inline;
+				memcpy(mutateString(stored) + 1, m.param2.begin(), m.param2.size());
+				treeMutations.push_back(arena, MutationRef(MutationRef::SetValue, m.param1, stored));
+			}
+		}
+		ASSERT(written == batchBytes);
+
+		if (batchBytes > 0) {
+			wait(openHeadSegment(self));
+			head = &self->m_valueLogSegments[self->m_valueLogHead];
+			wait(head->file->write(batch, batchBytes, batchOffset));
+			wait(head->file->sync());
+			head->size = batchOffset + batchBytes;
+			self->m_valueLogHeadSize = head->size;
+		}
+
+		for (auto const& m : treeMutations) {
+			if (m.type == MutationRef::SetValue) {
+				self->m_tree->set(KeyValueRef(m.param1, m.param2));
+			} else {
+				self->m_tree->clear(KeyRangeRef(m.param1, m.param2));
+			}
+		}
+		for (auto const& range : bulkRanges) {
+			self->m_tree->hintBulkLoad(range);
+		}
+		Future<Void> c = self->m_tree->commit();
+		self->m_tree->setOldestVersion(self->m_tree->getLatestVersion());
+		self->m_tree->setWriteVersion(self->m_tree->getWriteVersion() + 1);
+		wait(c);
+
+		if (collected.present()) {
+			TraceEvent("RedwoodValueLogSegmentCollected")
+			    .detail("FilePrefix", self->m_filePrefix)
+			    .detail("Segment", collected.get())
+			    .detail("Version", self->m_tree->getLastCommittedVersion());
+			self->m_retiredSegments.emplace_back(self->m_tree->getLastCommittedVersion(), collected.get());
+		}
+		wait(deleteRetiredSegments(self));
+		return Void();
+	}
+
+	// Scans up to gcBytesPerCommit of the oldest segment that is no longer appended to, adding the records that the
+	// btree still points to to relocated.  Returns the segment once it has been scanned to its end.
+	ACTOR static Future<Optional<uint32_t>> collectValueLogGarbage(KeyValueStoreRedwoodUnversioned* self,
+	                                                               Standalone<VectorRef<KeyValueRef>>* relocated) {
+		state VersionedBTree::BTreeCursor cur;
+		state ValueLogRecordHeader header;
+		state Key key;
+		state int64_t recordEnd;
+		state ValueLogPointer p;
+
+		int64_t sealedBytes = 0;
+		for (auto it = self->m_valueLogSegments.lower_bound(self->m_gcSegment);
+		     it != self->m_valueLogSegments.end() && it->first < self->m_valueLogHead;
+		     ++it) {
+			sealedBytes += it->second.size;
+		}
+		if (sealedBytes == 0 || sealedBytes < self->m_valueLogOptions.gcMinBytes) {
+			return Optional<uint32_t>();
+		}
+
+		auto it = self->m_valueLogSegments.lower_bound(self->m_gcSegment);
+		if (it->first != self->m_gcSegment) {
+			self->m_gcSegment = it->first;
+			self->m_gcOffset = 0;
+		}
+		state uint32_t segment = it->first;
+		state ValueLogSegment seg = it->second;
+		state int64_t end = self->m_gcOffset + self->m_valueLogOptions.gcBytesPerCommit;
+		// Reads at the last committed version see the result of every earlier commit, and this commit's mutations are
+		// not applied yet, so a record is live exactly when the btree points to it here
+		state Version version = self->m_tree->getLastCommittedVersion();
+
+		while (self->m_gcOffset < end && self->m_gcOffset < seg.size) {
+			if (self->m_gcOffset + sizeof(header) > seg.size) {
+				self->m_gcOffset = seg.size;
+				break;
+			}
+			int n = wait(seg.file->read(&header, sizeof(header), self->m_gcOffset));
+			recordEnd = self->m_gcOffset + sizeof(header) + header.keyLength + header.valueLength;
+			// A record cut short by a crash was never made durable, so nothing can point to it or anything after it
+			if (n != sizeof(header) || recordEnd > seg.size) {
+				self->m_gcOffset = seg.size;
+				break;
+			}
+
+			key = makeString(header.keyLength);
+			int keyBytes = wait(seg.file->read(mutateString(key), header.keyLength, self->m_gcOffset + sizeof(header)));
+			ASSERT(keyBytes == header.keyLength);
+
+			wait(self->m_tree->initBTreeCursor(&cur, version));
+			wait(cur.seekGTE(key, 0));
+			if (cur.isValid() && cur.get().key == key && isLogged(cur.get().value.get())) {
+				p = getValueLogPointer(cur.get().value.get());
+				if (p.segment == segment && p.offset == self->m_gcOffset + sizeof(header) + header.keyLength) {
+					Value v = wait(readLoggedValue(self, p));
+					relocated->push_back_deep(relocated->arena(), KeyValueRef(key, v));
+				}
+			}
+			self->m_gcOffset = recordEnd;
+		}
+
+		if (self->m_gcOffset < seg.size) {
+			return Optional<uint32_t>();
+		}
+		self->m_gcSegment = segment + 1;
+		self->m_gcOffset = 0;
+		return segment;
+	}
+
+	// A collected segment is deleted once no read in progress and no version the btree retains can refer to it
+	ACTOR static Future<Void> deleteRetiredSegments(KeyValueStoreRedwoodUnversioned* self) {
+		loop {
+			if (self->m_retiredSegments.empty()) {
+				return Void();
+			}
+			Version oldestNeeded = self->m_tree->getOldestVersion();
+			if (!self->m_activeReads->versions.empty()) {
+				oldestNeeded = std::min(oldestNeeded, *self->m_activeReads->versions.begin());
+			}
+			if (self->m_retiredSegments.front().first > oldestNeeded) {
+				return Void();
+			}
+			state uint32_t segment = self->m_retiredSegments.front().second;
+			self->m_retiredSegments.pop_front();
+			ASSERT(segment < self->m_valueLogHead);
+			self->m_valueLogSegments.erase(segment);
+			wait(IAsyncFileSystem::filesystem()->deleteFile(valueLogSegmentName(self->m_filePrefix, segment), true));
+		}
+	}
+
+	ACTOR static Future<Value> readLoggedValue(KeyValueStoreRedwoodUnversioned* self, ValueLogPointer p) {
+		auto it = self->m_valueLogSegments.find(p.segment);
+		if (it == self->m_valueLogSegments.end()) {
+			TraceEvent(SevError, "RedwoodValueLogMissingSegment")
+			    .detail("FilePrefix", self->m_filePrefix)
+			    .detail("Segment", p.segment);
+			throw file_corrupt();
+		}
+		state Reference<IAsyncFile> file = it->second.file;
+		state Value v = makeString(p.length);
+		int n = wait(file->read(mutateString(v), p.length, p.offset));
+		if (n != p.length || crc32c_append(0, v.begin(), v.size()) != p.checksum) {
+			TraceEvent(SevError, "RedwoodValueLogChecksumFailed")
+			    .detail("FilePrefix", self->m_filePrefix)
+			    .detail("Segment", p.segment)
+			    .detail("Offset", p.offset)
+			    .detail("Length", p.length);
+			throw checksum_failed();
+		}
+		return v;
+	}
+
+	// Returns the value that a value stored in the btree stands for
+	Future<Value> resolveValue(ValueRef stored) {
+		if (!m_valueLogEnabled) {
+			return Value(stored);
+		}
+		if (isLogged(stored)) {
+			return readLoggedValue(this, getValueLogPointer(stored));
+		}
+		return Value(stored.substr(1));
+	}
+
 	KeyValueStoreType getType() const override { return KeyValueStoreType::SSD_REDWOOD_V1; }
 
-	StorageBytes getStorageBytes() const override { return m_tree->getStorageBytes(); }
+	StorageBytes getStorageBytes() const override {
+		StorageBytes sb = m_tree->getStorageBytes();
+		int64_t logBytes = 0;
+		for (auto const& s : m_valueLogSegments) {
+			logBytes += s.second.size;
+		}
+		// The disk's free space already excludes the segments
+		sb.used += logBytes;
+		return sb;
+	}
 
 	Future<Void> getError() override { return delayed(m_error.getFuture()); };
 
 	void clear(KeyRangeRef range, const Arena* arena = 0) override {
 		debug_printf("CLEAR %s\n", printable(range).c_str());
+		if (m_valueLogEnabled) {
+			m_stagedMutations.push_back_deep(m_stagedMutations.arena(),
+			                                 MutationRef(MutationRef::ClearRange, range.begin, range.end));
+			return;
+		}
 		m_tree->clear(range);
 	}
 
 	void set(KeyValueRef keyValue, const Arena* arena = nullptr) override {
 		debug_printf("SET %s\n", printable(keyValue).c_str());
+		if (m_valueLogEnabled) {
+			m_stagedMutations.push_back_deep(m_stagedMutations.arena(),
+			                                 MutationRef(MutationRef::SetValue, keyValue.key, keyValue.value));
+			return;
+		}
 		m_tree->set(keyValue);
 	}
 
+	// The block still goes through set() so that large values reach the value log, and with the value log enabled its
+	// hint is staged along with its mutations.
+	void setBulk(Standalone<RangeResultRef> const& block) override {
+		if (block.empty()) {
+			return;
+		}
+		for (auto& kv : block) {
+			set(kv);
+		}
+		Arena arena;
+		KeyRangeRef range(block.front().key, keyAfter(block.back().key, arena));
+		if (m_valueLogEnabled) {
+			m_stagedBulkRanges.push_back_deep(m_stagedBulkRanges.arena(), range);
+			return;
+		}
+		m_tree->hintBulkLoad(range);
+	}
+
+	bool supportsBulkLoad() const override { return SERVER_KNOBS->REDWOOD_BULK_BUILD; }
+
 	Future<Standalone<RangeResultRef>> readRange(KeyRangeRef keys,
 	                                             int rowLimit = 1 << 30,
 	                                             int byteLimit = 1 << 30) override {
@@ -6038,6 +6590,7 @@ public:
 	                                                               int rowLimit,
 	                                                               int byteLimit) {
 		state VersionedBTree::BTreeCursor cur;
+		state ActiveRead activeRead(self->m_activeReads, self->m_tree->getLastCommittedVersion());
 		wait(self->m_tree->initBTreeCursor(&cur, self->m_tree->getLastCommittedVersion()));
 
 		state Reference<FlowLock> readLock = self->m_concurrentReads;
@@ -6047,6 +6600,8 @@ public:
 
 		state Standalone<RangeResultRef> result;
 		state int accumulatedBytes = 0;
+		state std::vector<std::pair<int, Future<Value>>> loggedValues;
+		state int logged;
 		ASSERT(byteLimit > 0);
 
 		if (rowLimit == 0) {
@@ -6067,7 +6622,7 @@ public:
 					if (kv.key >= keys.end) {
 						break;
 					}
-					accumulatedBytes += kv.expectedSize();
+					accumulatedBytes += kv.key.expectedSize() + self->logicalValueSize(kv.value);
 					result.push_back_deep(result.arena(), kv);
 					if (--rowLimit == 0 || accumulatedBytes >= byteLimit) {
 						break;
@@ -6092,7 +6647,7 @@ public:
 					if (kv.key < keys.begin) {
 						break;
 					}
-					accumulatedBytes += kv.expectedSize();
+					accumulatedBytes += kv.key.expectedSize() + self->logicalValueSize(kv.value);
 					result.push_back_deep(result.arena(), kv);
 					if (++rowLimit == 0 || accumulatedBytes >= byteLimit) {
 						break;
@@ -6108,6 +6663,21 @@ public:
 			}
 		}
 
+		if (self->m_valueLogEnabled) {
+			for (int i = 0; i < result.size(); ++i) {
+				if (isLogged(result[i].value)) {
+					loggedValues.emplace_back(i, readLoggedValue(self, getValueLogPointer(result[i].value)));
+				} else {
+					result[i].value = result[i].value.substr(1);
+				}
+			}
+			for (logged = 0; logged < loggedValues.size(); ++logged) {
+				Value v = wait(loggedValues[logged].second);
+				result[loggedValues[logged].first].value = v;
+				result.arena().dependsOn(v.arena());
+			}
+		}
+
 		result.more = rowLimit == 0 || accumulatedBytes >= byteLimit;
 		if (result.more) {
 			ASSERT(result.size() > 0);
@@ -6120,6 +6690,7 @@ public:
 	                                                    Key key,
 	                                                    Optional<UID> debugID) {
 		state VersionedBTree::BTreeCursor cur;
+		state ActiveRead activeRead(self->m_activeReads, self->m_tree->getLastCommittedVersion());
 		wait(self->m_tree->initBTreeCursor(&cur, self->m_tree->getLastCommittedVersion()));
 
 		state Reference<FlowLock> readLock = self->m_concurrentReads;
@@ -6129,7 +6700,8 @@ public:
 
 		wait(cur.seekGTE(key, 0));
 		if (cur.isValid() && cur.get().key == key) {
-			return cur.get().value.get();
+			Value v = wait(self->resolveValue(cur.get().value.get()));
+			return v;
 		}
 		return Optional<Value>();
 	}
@@ -6143,6 +6715,7 @@ public:
 	                                                          int maxLength,
 	                                                          Optional<UID> debugID) {
 		state VersionedBTree::BTreeCursor cur;
+		state ActiveRead activeRead(self->m_activeReads, self->m_tree->getLastCommittedVersion());
 		wait(self->m_tree->initBTreeCursor(&cur, self->m_tree->getLastCommittedVersion()));
 
 		state Reference<FlowLock> readLock = self->m_concurrentReads;
@@ -6152,7 +6725,8 @@ public:
 
 		wait(cur.seekGTE(key, 0));
 		if (cur.isValid() && cur.get().key == key) {
-			Value v = cur.get().value.get();
+			// Logged values are read whole so their checksum can be verified
+			Value v = wait(self->resolveValue(cur.get().value.get()));
 			int len = std::min(v.size(), maxLength);
 			return Value(v.substr(0, len));
 		}
@@ -6176,6 +6750,20 @@ private:
 	Promise<Void> m_error;
 	Reference<FlowLock> m_concurrentReads;
 
+	RedwoodValueLogOptions m_valueLogOptions;
+	bool m_newStore;
+	bool m_valueLogEnabled = false;
+	std::map<uint32_t, ValueLogSegment> m_valueLogSegments;
+	uint32_t m_valueLogHead = 0;
+	int64_t m_valueLogHeadSize = 0;
+	Standalone<VectorRef<MutationRef>> m_stagedMutations;
+	Standalone<VectorRef<KeyRangeRef>> m_stagedBulkRanges;
+	Future<Void> m_valueLogCommit = Void();
+	uint32_t m_gcSegment = 0;
+	int64_t m_gcOffset = 0;
+	std::deque<std::pair<Version, uint32_t>> m_retiredSegments; // Collected segments and the version that collected them
+	Reference<ActiveReads> m_activeReads;
+
 	template <typename T>
 	inline Future<T> catchError(Future<T> f) {
 		return forwardError(f, m_error);
@@ -8043,6 +8631,206 @@ TEST_CASE(":/redwood/correctness/pager/cow") {
 	return Void();
 }
 
+ACTOR Future<Void> verifyKVStoreContents(IKeyValueStore* kvs, std::map<Key, Value>* model) {
+	state std::map<Key, Value>::iterator i;
+	for (i = model->begin(); i != model->end(); ++i) {
+		Optional<Value> v = wait(kvs->readValue(i->first));
+		ASSERT(v.present() && v.get() == i->second);
+	}
+
+	Standalone<RangeResultRef> all = wait(kvs->readRange(KeyRangeRef(LiteralStringRef(""), LiteralStringRef("\xff"))));
+	ASSERT(all.size() == model->size() && !all.more);
+	i = model->begin();
+	for (auto const& kv : all) {
+		ASSERT(kv.key == i->first && kv.value == i->second);
+		++i;
+	}
+	return Void();
+}
+
+TEST_CASE("/redwood/correctness/valueLog") {
+	state std::string fileName = params.get("fileName").orDefault("unittest_valueLog.redwood");
+	deleteFile(fileName);
+	for (uint32_t segment : KeyValueStoreRedwoodUnversioned::listValueLogSegments(fileName)) {
+		deleteFile(KeyValueStoreRedwoodUnversioned::valueLogSegmentName(fileName, segment));
+	}
+
+	// Small segments and no garbage collection threshold, so that overwrites fill and collect many segments
+	state RedwoodValueLogOptions options;
+	options.threshold = 100;
+	options.segmentBytes = 50000;
+	options.gcMinBytes = 0;
+	options.gcBytesPerCommit = 100000;
+
+	state IKeyValueStore* kvs = new KeyValueStoreRedwoodUnversioned(fileName, UID(), options);
+	wait(kvs->init());
+
+	state std::map<Key, Value> model;
+	state int commits;
+	for (commits = 0; commits < 100; ++commits) {
+		for (int i = 0; i < 20; ++i) {
+			Key key = StringRef(format("key%03d", deterministicRandom()->randomInt(0, 50)));
+			int valueSize = deterministicRandom()->randomChoice(std::vector<int>{ 10, 500, 3000 });
+			Value value = StringRef(deterministicRandom()->randomAlphaNumeric(valueSize));
+			kvs->set(KeyValueRef(key, value));
+			model[key] = value;
+		}
+		if (deterministicRandom()->random01() < 0.1) {
+			KeyRange range = KeyRangeRef(StringRef(format("key%03d", deterministicRandom()->randomInt(0, 25))),
+			                             StringRef(format("key%03d", deterministicRandom()->randomInt(25, 50))));
+			kvs->clear(range);
+			model.erase(model.lower_bound(range.begin), model.lower_bound(range.end));
+		}
+		wait(kvs->commit());
+	}
+	wait(verifyKVStoreContents(kvs, &model));
+	// Collected segments are deleted, so the log does not grow with every overwrite
+	ASSERT(KeyValueStoreRedwoodUnversioned::listValueLogSegments(fileName).size() < 20);
+
+	state Future<Void> closed = kvs->onClosed();
+	kvs->close();
+	wait(closed);
+
+	// The store keeps using the value log after reopening, regardless of the threshold it is opened with
+	options.threshold = 0;
+	kvs = new KeyValueStoreRedwoodUnversioned(fileName, UID(), options);
+	wait(kvs->init());
+	wait(verifyKVStoreContents(kvs, &model));
+
+	// Once no value is logged, losing every segment file must not change how the btree's values are read
+	for (auto& kv : model) {
+		kv.second = StringRef(deterministicRandom()->randomAlphaNumeric(10));
+		kvs->set(KeyValueRef(kv.first, kv.second));
+	}
+	wait(kvs->commit());
+	closed = kvs->onClosed();
+	kvs->close();
+	wait(closed);
+	for (uint32_t segment : KeyValueStoreRedwoodUnversioned::listValueLogSegments(fileName)) {
+		deleteFile(KeyValueStoreRedwoodUnversioned::valueLogSegmentName(fileName, segment));
+	}
+	kvs = new KeyValueStoreRedwoodUnversioned(fileName, UID(), options);
+	wait(kvs->init());
+	wait(verifyKVStoreContents(kvs, &model));
+	// No segment is created until a value is logged
+	ASSERT(KeyValueStoreRedwoodUnversioned::listValueLogSegments(fileName).empty());
+
+	closed = kvs->onClosed();
+	kvs->dispose();
+	wait(closed);
+	ASSERT(KeyValueStoreRedwoodUnversioned::listValueLogSegments(fileName).empty());
+
+	return Void();
+}
+
+// Stores written before the store flags existed have a format 8 meta key with nothing after the root
+TEST_CASE("/redwood/correctness/formatUpgrade") {
+	state std::string fileName = params.get("fileName").orDefault("unittest_formatUpgrade.redwood");
+	deleteFile(fileName);
+
+	// Without the value log, so that the flags written after the meta key are all clear
+	state RedwoodValueLogOptions options;
+	options.threshold = 0;
+	state IKeyValueStore* kvs = new KeyValueStoreRedwoodUnversioned(fileName, UID(), options);
+	wait(kvs->init());
+	state std::map<Key, Value> model;
+	state int i;
+	for (i = 0; i < 100; ++i) {
+		Key key = StringRef(format("key%03d", i));
+		Value value = StringRef(deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 200)));
+		kvs->set(KeyValueRef(key, value));
+		model[key] = value;
+	}
+	wait(kvs->commit());
+	state Future<Void> closed = kvs->onClosed();
+	kvs->close();
+	wait(closed);
+
+	// Rewrite the meta key as an older binary would have left it
+	state IPager2* pager = new DWALPager(SERVER_KNOBS->REDWOOD_DEFAULT_PAGE_SIZE, fileName, 0, 0);
+	wait(success(pager->init()));
+	state Key meta = pager->getMetaKey();
+	ASSERT(meta.size() > sizeof(uint16_t) && *(uint16_t*)meta.begin() == 8 && meta[meta.size() - 1] == 0);
+	pager->setMetaKey(meta.substr(0, meta.size() - 1));
+	wait(pager->commit());
+	closed = pager->onClosed();
+	pager->close();
+	wait(closed);
+
+	kvs = new KeyValueStoreRedwoodUnversioned(fileName, UID(), options);
+	wait(kvs->init());
+	wait(verifyKVStoreContents(kvs, &model));
+
+	// The next commit writes the flags after the meta key again
+	kvs->set(KeyValueRef(LiteralStringRef("key000"), LiteralStringRef("")));
+	model[LiteralStringRef("key000")] = Value();
+	wait(kvs->commit());
+	closed = kvs->onClosed();
+	kvs->close();
+	wait(closed);
+
+	kvs = new KeyValueStoreRedwoodUnversioned(fileName, UID(), options);
+	wait(kvs->init());
+	wait(verifyKVStoreContents(kvs, &model));
+	closed = kvs->onClosed();
+	kvs->dispose();
+	wait(closed);
+
+	return Void();
+}
+
+TEST_CASE("/redwood/correctness/bulkBuild") {
+	state std::string fileName = params.get("fileName").orDefault("unittest_bulkBuild.redwood");
+	deleteFile(fileName);
+	state bool bulkBuild = SERVER_KNOBS->REDWOOD_BULK_BUILD;
+	ASSERT(const_cast<ServerKnobs*>(SERVER_KNOBS)->setKnob("redwood_bulk_build", "true"));
+
+	state IKeyValueStore* kvs = openKVStore(KeyValueStoreType::SSD_REDWOOD_V1, fileName, UID(), 0);
+	wait(kvs->init());
+	ASSERT(kvs->supportsBulkLoad());
+
+	// Load blocks of sorted keys, the first into the empty tree and the rest next to and between existing data.  Each
+	// commit also carries a few ordinary sets outside the block, which are not part of the hinted range.
+	state std::map<Key, Value> model;
+	state int block;
+	for (block = 0; block < 20; ++block) {
+		Standalone<RangeResultRef> rows;
+		int first = deterministicRandom()->randomInt(0, 10000);
+		int count = deterministicRandom()->randomInt(1, 500);
+		for (int i = first; i < first + count; ++i) {
+			Key key = StringRef(format("key%06d", i));
+			Value value = StringRef(deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 200)));
+			rows.push_back_deep(rows.arena(), KeyValueRef(key, value));
+			model[key] = value;
+		}
+		kvs->clear(KeyRangeRef(rows.front().key, keyAfter(rows.back().key)));
+		kvs->setBulk(rows);
+		for (int i = 0; i < 3; ++i) {
+			Key key = StringRef(format("other%06d", deterministicRandom()->randomInt(0, 10000)));
+			Value value = StringRef(deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 200)));
+			kvs->set(KeyValueRef(key, value));
+			model[key] = value;
+		}
+		wait(kvs->commit());
+	}
+	wait(verifyKVStoreContents(kvs, &model));
+
+	state Future<Void> closed = kvs->onClosed();
+	kvs->close();
+	wait(closed);
+
+	kvs = openKVStore(KeyValueStoreType::SSD_REDWOOD_V1, fileName, UID(), 0);
+	wait(kvs->init());
+	wait(verifyKVStoreContents(kvs, &model));
+
+	closed = kvs->onClosed();
+	kvs->dispose();
+	wait(closed);
+
+	ASSERT(const_cast<ServerKnobs*>(SERVER_KNOBS)->setKnob("redwood_bulk_build", bulkBuild ? "true" : "false"));
+	return Void();
+}
+
 TEST_CASE(":/redwood/performance/set") {
 	state SignalableActorCollection actors;
 
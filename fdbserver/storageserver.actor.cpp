@@ -172,6 +172,8 @@ struct StorageServerDisk {
 
 	void writeMutation(MutationRef mutation);
 	void writeKeyValue(KeyValueRef kv);
+	void writeKeyValueBlock(Standalone<RangeResultRef> const& block) { storage->setBulk(block); }
+	bool supportsBulkLoad() const { return storage->supportsBulkLoad(); }
 	void clearRange(KeyRangeRef keys);
 
 	Future<Void> getError() { return storage->getError(); }
@@ -607,13 +609,12 @@ public:
 			  : tag(tag), rate(rate), fractionalBusyness(fractionalBusyness) {}
 		};
 
-		TransactionTagMap<int64_t> intervalCounts;
-		int64_t intervalTotalSampledCount = 0;
-		TransactionTag busiestTag;
-		int64_t busiestTagCount = 0;
+		TagCostSketch intervalCosts;
 		double intervalStart = 0;
 
-		Optional<TagInfo> previousBusiestTag;
+		std::vector<TagInfo> previousBusiestTags;
+
+		TransactionTagCounter() : intervalCosts(SERVER_KNOBS->STORAGE_TAG_COST_SKETCH_SIZE) {}
 
 		int64_t costFunction(int64_t bytes) { return bytes / SERVER_KNOBS->READ_COST_BYTE_FACTOR + 1; }
 
@@ -622,43 +623,41 @@ public:
 				TEST(true); // Tracking tag on storage server
 				double cost = costFunction(bytes);
 				for (auto& tag : tags.get()) {
-					int64_t& count = intervalCounts[TransactionTag(tag, tags.get().getArena())];
-					count += cost;
-					if (count > busiestTagCount) {
-						busiestTagCount = count;
-						busiestTag = tag;
-					}
+					intervalCosts.add(TransactionTag(tag, tags.get().getArena()), cost);
 				}
-
-				intervalTotalSampledCount += cost;
 			}
 		}
 
 		void startNewInterval(UID id) {
 			double elapsed = now() - intervalStart;
-			previousBusiestTag.reset();
+			previousBusiestTags.clear();
 			if (intervalStart > 0 && CLIENT_KNOBS->READ_TAG_SAMPLE_RATE > 0 && elapsed > 0) {
-				double rate = busiestTagCount / CLIENT_KNOBS->READ_TAG_SAMPLE_RATE / elapsed;
-				if (rate > SERVER_KNOBS->MIN_TAG_READ_PAGES_RATE) {
-					previousBusiestTag = TagInfo(busiestTag, rate, (double)busiestTagCount / intervalTotalSampledCount);
+				// Report the busiest few tags rather than just one, so that ratekeeper can throttle all of the tags
+				// that are overloading this server at once. Only the cost each tag is known to have incurred counts.
+				auto busiest = intervalCosts.topK(SERVER_KNOBS->AUTO_THROTTLE_TAGS_PER_STORAGE_SERVER);
+				for (const auto& e : busiest) {
+					double rate = e.guaranteedCost() / CLIENT_KNOBS->READ_TAG_SAMPLE_RATE / elapsed;
+					if (rate > SERVER_KNOBS->MIN_TAG_READ_PAGES_RATE) {
+						previousBusiestTags.emplace_back(
+						    e.tag, rate, (double)e.guaranteedCost() / intervalCosts.total());
+					}
 				}
 
 				TraceEvent("BusiestReadTag", id)
 				    .detail("Elapsed", elapsed)
-				    .detail("Tag", printable(busiestTag))
-				    .detail("TagCost", busiestTagCount)
-				    .detail("TotalSampledCost", intervalTotalSampledCount)
-				    .detail("Reported", previousBusiestTag.present())
+				    .detail("Tag", busiest.empty() ? std::string() : printable(busiest[0].tag))
+				    .detail("TagCost", busiest.empty() ? 0 : busiest[0].cost)
+				    .detail("TotalSampledCost", intervalCosts.total())
+				    .detail("Reported", !previousBusiestTags.empty())
+				    .detail("ReportedTags", previousBusiestTags.size())
 				    .trackLatest(id.toString() + "/BusiestReadTag");
 			}
 
-			intervalCounts.clear();
-			intervalTotalSampledCount = 0;
-			busiestTagCount = 0;
+			intervalCosts.clear();
 			intervalStart = now();
 		}
 
-		Optional<TagInfo> getBusiestTag() const { return previousBusiestTag; }
+		std::vector<TagInfo> const& getBusiestTags() const { return previousBusiestTags; }
 	};
 
 	TransactionTagCounter transactionTagCounter;
@@ -2052,11 +2051,15 @@ void getQueuingMetrics(StorageServer* self, StorageQueuingMetricsRequest const&
 	reply.diskUsage = self->diskUsage;
 	reply.durableVersion = self->durableVersion.get();
 
-	Optional<StorageServer::TransactionTagCounter::TagInfo> busiestTag = self->transactionTagCounter.getBusiestTag();
-	reply.busiestTag = busiestTag.map<TransactionTag>(
-	    [](StorageServer::TransactionTagCounter::TagInfo tagInfo) { return tagInfo.tag; });
-	reply.busiestTagFractionalBusyness = busiestTag.present() ? busiestTag.get().fractionalBusyness : 0.0;
-	reply.busiestTagRate = busiestTag.present() ? busiestTag.get().rate : 0.0;
+	auto const& busiestTags = self->transactionTagCounter.getBusiestTags();
+	for (const auto& tagInfo : busiestTags) {
+		reply.busiestTags.emplace_back(tagInfo.tag, tagInfo.rate, tagInfo.fractionalBusyness);
+	}
+	if (!busiestTags.empty()) {
+		reply.busiestTag = busiestTags[0].tag;
+	}
+	reply.busiestTagFractionalBusyness = busiestTags.empty() ? 0.0 : busiestTags[0].fractionalBusyness;
+	reply.busiestTagRate = busiestTags.empty() ? 0.0 : busiestTags[0].rate;
 
 	req.reply.send(reply);
 }
@@ -2651,9 +2654,27 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 
 				// Write this_block to storage
 				state KeyValueRef* kvItr = this_block.begin();
-				for (; kvItr != this_block.end(); ++kvItr) {
-					data->storage.writeKeyValue(*kvItr);
-					wait(yield());
+				if (SERVER_KNOBS->FETCH_KEYS_BULK_LOAD && data->storage.supportsBulkLoad()) {
+					TEST(true); // Fetched block bulk loaded
+					// setBulk() can still do work for each pair, so the block is handed over in slices that end
+					// wherever this actor needs to yield
+					state KeyValueRef* sliceBegin = this_block.begin();
+					while (kvItr != this_block.end()) {
+						++kvItr;
+						if (kvItr == this_block.end() || g_network->check_yield(TaskPriority::DefaultYield)) {
+							Standalone<RangeResultRef> slice(
+							    RangeResultRef(VectorRef<KeyValueRef>(sliceBegin, kvItr - sliceBegin), false),
+							    this_block.arena());
+							data->storage.writeKeyValueBlock(slice);
+							sliceBegin = kvItr;
+							wait(yield());
+						}
+					}
+				} else {
+					for (; kvItr != this_block.end(); ++kvItr) {
+						data->storage.writeKeyValue(*kvItr);
+						wait(yield());
+					}
 				}
 
 				kvItr = this_block.begin();
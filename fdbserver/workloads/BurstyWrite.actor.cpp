@@ -0,0 +1,209 @@
+/*
+ * BurstyWrite.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2021 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbrpc/ContinuousSample.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/ReadYourWrites.h"
+#include "fdbclient/StatusClient.h"
+#include "fdbserver/Knobs.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Alternates between bursts of heavy blind writes and quiet periods, so that storage queues repeatedly fill and drain
+// and ratekeeper has to keep adjusting its limit. Commits are counted in one second buckets, and the variation of
+// those buckets within the bursts, together with commit latency, shows how steadily ratekeeper admitted the load.
+// In simulation the test turns on RATEKEEPER_PREDICTIVE_CONTROL and checks, from ratekeeper's metrics in status, that
+// the worst storage queue never grew to the point where the spring controller alone would have held it.
+struct BurstyWriteWorkload : TestWorkload {
+	double testDuration, burstDuration, quietDuration, burstTransactionsPerSecond, quietTransactionsPerSecond;
+	int actorCount, writesPerTransaction, valueBytes, nodeCount;
+	vector<Future<Void>> clients;
+	PerfIntCounter transactions, retries;
+	ContinuousSample<double> commitLatencies;
+	std::map<int, int64_t> burstCommitsPerSecond;
+	double startTime;
+	// Sampled from ratekeeper's metrics in status while the test runs
+	double maxWorstStorageQueue;
+	std::vector<double> burstTpsLimits;
+
+	BurstyWriteWorkload(WorkloadContext const& wcx)
+	  : TestWorkload(wcx), transactions("Transactions"), retries("Retries"), commitLatencies(2000), startTime(0),
+	    maxWorstStorageQueue(0) {
+		testDuration = getOption(options, LiteralStringRef("testDuration"), 120.0);
+		burstDuration = getOption(options, LiteralStringRef("burstDuration"), 5.0);
+		quietDuration = getOption(options, LiteralStringRef("quietDuration"), 5.0);
+		burstTransactionsPerSecond =
+		    getOption(options, LiteralStringRef("burstTransactionsPerSecond"), 5000.0) / clientCount;
+		quietTransactionsPerSecond =
+		    getOption(options, LiteralStringRef("quietTransactionsPerSecond"), 100.0) / clientCount;
+		actorCount =
+		    getOption(options, LiteralStringRef("actorsPerClient"), std::max(1, (int)burstTransactionsPerSecond / 5));
+		writesPerTransaction = getOption(options, LiteralStringRef("writesPerTransaction"), 10);
+		valueBytes = getOption(options, LiteralStringRef("valueBytes"), 1000);
+		nodeCount = getOption(options, LiteralStringRef("nodeCount"), 100000);
+	}
+
+	std::string description() const override { return "BurstyWrite"; }
+
+	Future<Void> setup(Database const& cx) override {
+		if (g_network->isSimulated()) {
+			ASSERT(const_cast<ServerKnobs*>(SERVER_KNOBS)->setKnob("ratekeeper_predictive_control", "true"));
+		}
+		return Void();
+	}
+
+	Future<Void> start(Database const& cx) override {
+		startTime = now();
+		for (int c = 0; c < actorCount; c++) {
+			clients.push_back(timeout(writer(cx->clone(), this), testDuration, Void()));
+		}
+		if (clientId == 0) {
+			clients.push_back(timeout(monitorRatekeeper(cx, this), testDuration, Void()));
+		}
+		return waitForAll(clients);
+	}
+
+	Future<bool> check(Database const& cx) override {
+		clients.clear();
+		if (transactions.getValue() == 0) {
+			return false;
+		}
+		// Predictive control limits the input rate before a queue reaches the spring region, so no queue should get
+		// as far as the target that the spring controller holds queues at
+		if (clientId == 0 && g_network->isSimulated() &&
+		    maxWorstStorageQueue >= SERVER_KNOBS->TARGET_BYTES_PER_STORAGE_SERVER) {
+			TraceEvent(SevError, "BurstyWriteStorageQueueUnbounded")
+			    .detail("MaxWorstStorageQueue", maxWorstStorageQueue)
+			    .detail("TargetBytes", SERVER_KNOBS->TARGET_BYTES_PER_STORAGE_SERVER)
+			    .detail("PredictiveControl", SERVER_KNOBS->RATEKEEPER_PREDICTIVE_CONTROL);
+			return false;
+		}
+		return true;
+	}
+
+	// The coefficient of variation of the samples; 0 is perfectly steady.
+	template <class C>
+	static double variation(C const& samples) {
+		if (samples.size() < 2) {
+			return 0;
+		}
+		double sum = 0, sumSquares = 0;
+		for (double x : samples) {
+			sum += x;
+			sumSquares += x * x;
+		}
+		double n = samples.size();
+		double mean = sum / n;
+		return mean > 0 ? sqrt(std::max(0.0, sumSquares / n - mean * mean)) / mean : 0;
+	}
+
+	// The variation of the per-second commit counts during bursts
+	double burstThroughputVariation() const {
+		std::vector<double> commits;
+		for (const auto& [second, count] : burstCommitsPerSecond) {
+			commits.push_back(count);
+		}
+		return variation(commits);
+	}
+
+	void getMetrics(vector<PerfMetric>& m) override {
+		m.push_back(transactions.getMetric());
+		m.push_back(retries.getMetric());
+		m.emplace_back("Transactions/sec", transactions.getValue() / testDuration, false);
+		m.emplace_back("Burst Throughput Variation", burstThroughputVariation(), false);
+		if (clientId == 0) {
+			m.emplace_back("Burst TPS Limit Variation", variation(burstTpsLimits), false);
+			m.emplace_back("Max Worst Storage Queue (bytes)", maxWorstStorageQueue, false);
+		}
+		m.emplace_back("Median Commit Latency (ms, averaged)", 1000 * commitLatencies.median(), true);
+		m.emplace_back("99% Commit Latency (ms, averaged)", 1000 * commitLatencies.percentile(0.99), true);
+		m.emplace_back("Max Commit Latency (ms, averaged)", 1000 * commitLatencies.max(), true);
+
+		TraceEvent("BurstyWriteMetrics")
+		    .detail("Transactions", transactions.getValue())
+		    .detail("BurstThroughputVariation", burstThroughputVariation())
+		    .detail("BurstTpsLimitVariation", variation(burstTpsLimits))
+		    .detail("MaxWorstStorageQueue", maxWorstStorageQueue)
+		    .detail("MedianCommitLatency", commitLatencies.median())
+		    .detail("P99CommitLatency", commitLatencies.percentile(0.99))
+		    .detail("PredictiveControl", SERVER_KNOBS->RATEKEEPER_PREDICTIVE_CONTROL);
+	}
+
+	bool inBurst(double t) const { return fmod(t - startTime, burstDuration + quietDuration) < burstDuration; }
+
+	// Status reports the worst storage queue and the transaction rate limit from ratekeeper's RkUpdate event
+	ACTOR static Future<Void> monitorRatekeeper(Database cx, BurstyWriteWorkload* self) {
+		loop {
+			wait(delay(1.0));
+			try {
+				StatusObject status = wait(StatusClient::statusFetcher(cx));
+				StatusObjectReader reader(status);
+				double worstQueue, tpsLimit;
+				if (reader.get("cluster.qos.worst_queue_bytes_storage_server", worstQueue)) {
+					self->maxWorstStorageQueue = std::max(self->maxWorstStorageQueue, worstQueue);
+				}
+				if (self->inBurst(now()) && reader.get("cluster.qos.transactions_per_second_limit", tpsLimit)) {
+					self->burstTpsLimits.push_back(tpsLimit);
+				}
+			} catch (Error& e) {
+				if (e.code() == error_code_actor_cancelled) {
+					throw;
+				}
+				TraceEvent("BurstyWriteStatusError").error(e);
+			}
+		}
+	}
+
+	ACTOR static Future<Void> writer(Database cx, BurstyWriteWorkload* self) {
+		state double lastTime = now();
+		state Standalone<StringRef> value = makeString(self->valueBytes);
+		memset(mutateString(value), 'b', self->valueBytes);
+		loop {
+			double tps = self->inBurst(now()) ? self->burstTransactionsPerSecond : self->quietTransactionsPerSecond;
+			wait(poisson(&lastTime, self->actorCount / std::max(tps, 1.0)));
+			state ReadYourWritesTransaction tr(cx);
+			state double commitStart;
+			loop {
+				try {
+					for (int i = 0; i < self->writesPerTransaction; i++) {
+						tr.set(StringRef(format("bursty%08x", deterministicRandom()->randomInt(0, self->nodeCount))),
+						       value);
+					}
+					commitStart = now();
+					wait(tr.commit());
+					break;
+				} catch (Error& e) {
+					++self->retries;
+					wait(tr.onError(e));
+				}
+			}
+			self->commitLatencies.addSample(now() - commitStart);
+			++self->transactions;
+			// Only seconds entirely inside a burst are comparable with each other
+			int second = now() - self->startTime;
+			if (self->inBurst(self->startTime + second) && self->inBurst(self->startTime + second + 0.999)) {
+				self->burstCommitsPerSecond[second]++;
+			}
+		}
+	}
+};
+
+WorkloadFactory<BurstyWriteWorkload> BurstyWriteWorkloadFactory("BurstyWrite");
@@ -198,16 +198,16 @@ struct KVStoreTestWorkload : TestWorkload {
 	bool enabled, saturation;
 	double testDuration, operationsPerSecond;
 	double commitFraction, setFraction;
-	int nodeCount, keyBytes, valueBytes;
+	int nodeCount, keyBytes, valueBytes, clearChunk;
 	bool doSetup, doClear, doCount;
 	std::string filename;
 	PerfIntCounter reads, sets, commits;
 	TestHistogram<float> readLatency, commitLatency;
-	double setupTook;
+	double setupTook, clearTook;
 	std::string storeType;
 
 	KVStoreTestWorkload(WorkloadContext const& wcx)
-	  : TestWorkload(wcx), reads("Reads"), sets("Sets"), commits("Commits"), setupTook(0) {
+	  : TestWorkload(wcx), reads("Reads"), sets("Sets"), commits("Commits"), setupTook(0), clearTook(0) {
 		enabled = !clientId; // only do this on the "first" client
 		testDuration = getOption(options, LiteralStringRef("testDuration"), 10.0);
 		operationsPerSecond = getOption(options, LiteralStringRef("operationsPerSecond"), 100e3);
@@ -218,6 +218,7 @@ struct KVStoreTestWorkload : TestWorkload {
 		valueBytes = getOption(options, LiteralStringRef("valueBytes"), 8);
 		doSetup = getOption(options, LiteralStringRef("setup"), false);
 		doClear = getOption(options, LiteralStringRef("clear"), false);
+		clearChunk = getOption(options, LiteralStringRef("clearChunk"), 1000000);
 		doCount = getOption(options, LiteralStringRef("count"), false);
 		filename = getOption(options, LiteralStringRef("filename"), Value()).toString();
 		saturation = getOption(options, LiteralStringRef("saturation"), false);
@@ -241,6 +242,10 @@ struct KVStoreTestWorkload : TestWorkload {
 	void getMetrics(vector<PerfMetric>& m) override {
 		if (setupTook)
 			m.push_back(PerfMetric("SetupTook", setupTook, false));
+		if (clearTook) {
+			m.push_back(PerfMetric("ClearTook", clearTook, false));
+			m.push_back(PerfMetric("Cleared Nodes/sec", nodeCount / clearTook, false));
+		}
 
 		m.push_back(reads.getMetric());
 		m.push_back(sets.getMetric());
@@ -357,13 +362,27 @@ ACTOR Future<Void> testKVStoreMain(KVStoreTestWorkload* workload, KVTest* ptest)
 	}
 
 	if (workload->doClear) {
-		state int chunk = 1000000;
 		t = timer();
-		for (i = 0; i < workload->nodeCount; i += chunk) {
-			test.store->clear(KeyRangeRef(test.makeKey(i), test.makeKey(i + chunk)));
+		for (i = 0; i < workload->nodeCount; i += workload->clearChunk) {
+			test.store->clear(KeyRangeRef(test.makeKey(i), test.makeKey(i + workload->clearChunk)));
 			wait(test.store->commit());
 		}
-		TraceEvent("KVStoreClear").detail("Took", timer() - t);
+		workload->clearTook = timer() - t;
+		TraceEvent("KVStoreClear")
+		    .detail("Took", workload->clearTook)
+		    .detail("Count", workload->nodeCount)
+		    .detail("Chunk", workload->clearChunk);
+
+		// Reads over the cleared range should not have to wade through what was there before
+		state double readsBegin = timer();
+		state int64_t readsLeft = 0;
+		for (i = 0; i < workload->nodeCount; i += workload->clearChunk) {
+			Standalone<RangeResultRef> kv =
+			    wait(test.store->readRange(KeyRangeRef(test.makeKey(i), test.makeKey(i + workload->clearChunk)), 1));
+			readsLeft += kv.size();
+		}
+		ASSERT(readsLeft == 0);
+		TraceEvent("KVStoreReadAfterClear").detail("Took", timer() - readsBegin);
 	}
 
 	return Void();
@@ -0,0 +1,198 @@
+/*
+ * ReadHotspotBalance.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2021 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/ManagementAPI.actor.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/ReadYourWrites.h"
+#include "fdbserver/QuietDatabase.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Sends most reads to a small, contiguous slice of the keyspace so that the storage team holding it serves far more
+// read bandwidth than the others.  Read rebalancing is turned on in simulation, and the test checks that data
+// distribution moved load off the hottest storage server by the end of the run.
+struct ReadHotspotBalanceWorkload : TestWorkload {
+	int nodeCount, valueBytes, actorCount;
+	double testDuration, transactionsPerSecond, hotKeyFraction, hotReadFraction;
+	vector<Future<Void>> clients;
+	PerfIntCounter reads, errors;
+	// The ratio of the busiest storage server's read bandwidth to the mean, at its highest and when last measured
+	double peakMaxToMeanReadRatio, maxToMeanReadRatio;
+
+	ReadHotspotBalanceWorkload(WorkloadContext const& wcx)
+	  : TestWorkload(wcx), reads("Reads"), errors("Errors"), peakMaxToMeanReadRatio(0), maxToMeanReadRatio(0) {
+		testDuration = getOption(options, LiteralStringRef("testDuration"), 120.0);
+		transactionsPerSecond = getOption(options, LiteralStringRef("transactionsPerSecond"), 1000.0) / clientCount;
+		actorCount = getOption(options, LiteralStringRef("actorsPerClient"), std::max(1, (int)transactionsPerSecond / 5));
+		nodeCount = getOption(options, LiteralStringRef("nodeCount"), 5000);
+		valueBytes = getOption(options, LiteralStringRef("valueBytes"), 1000);
+		hotKeyFraction = getOption(options, LiteralStringRef("hotKeyFraction"), 0.05);
+		hotReadFraction = getOption(options, LiteralStringRef("hotReadFraction"), 0.9);
+	}
+
+	std::string description() const override { return "ReadHotspotBalance"; }
+
+	Future<Void> setup(Database const& cx) override {
+		if (g_network->isSimulated()) {
+			// Read bandwidth is only sampled with READ_SAMPLING_ENABLED, and the default interval, cooldown and
+			// threshold are sized for production clusters rather than a test of a couple of minutes
+			auto knobs = const_cast<ServerKnobs*>(SERVER_KNOBS);
+			ASSERT(knobs->setKnob("read_sampling_enabled", "true"));
+			ASSERT(knobs->setKnob("dd_read_rebalance", "true"));
+			ASSERT(knobs->setKnob("dd_read_rebalance_interval", "1.0"));
+			ASSERT(knobs->setKnob("dd_read_rebalance_cooldown", "5.0"));
+			ASSERT(knobs->setKnob("dd_read_rebalance_min_bytes_per_ksec", "1000000"));
+		}
+		return clientId == 0 ? _setup(cx, this) : Void();
+	}
+
+	Future<Void> start(Database const& cx) override {
+		for (int c = 0; c < actorCount; c++) {
+			clients.push_back(timeout(reader(cx->clone(), this, actorCount / transactionsPerSecond), testDuration, Void()));
+		}
+		if (clientId == 0) {
+			clients.push_back(timeout(monitor(cx, this), testDuration, Void()));
+		}
+		return waitForAll(clients);
+	}
+
+	Future<bool> check(Database const& cx) override {
+		clients.clear();
+		if (clientId != 0)
+			return true;
+		return _check(cx, this);
+	}
+
+	void getMetrics(vector<PerfMetric>& m) override {
+		m.push_back(reads.getMetric());
+		m.push_back(errors.getMetric());
+		if (clientId == 0) {
+			m.emplace_back("PeakMaxToMeanReadRatio", peakMaxToMeanReadRatio, false);
+			m.emplace_back("MaxToMeanReadRatio", maxToMeanReadRatio, false);
+		}
+	}
+
+	Key keyForIndex(int n) const { return StringRef(format("readhot%08x", n)); }
+
+	int randomKeyIndex() const {
+		int hotKeys = std::max(1, (int)(nodeCount * hotKeyFraction));
+		if (deterministicRandom()->random01() < hotReadFraction) {
+			return deterministicRandom()->randomInt(0, hotKeys);
+		}
+		return deterministicRandom()->randomInt(0, nodeCount);
+	}
+
+	ACTOR static Future<Void> _setup(Database cx, ReadHotspotBalanceWorkload* self) {
+		state int begin = 0;
+		state Standalone<StringRef> value = makeString(self->valueBytes);
+		memset(mutateString(value), 'v', self->valueBytes);
+		while (begin < self->nodeCount) {
+			state ReadYourWritesTransaction tr(cx);
+			loop {
+				try {
+					for (int i = begin; i < std::min(begin + 100, self->nodeCount); i++) {
+						tr.set(self->keyForIndex(i), value);
+					}
+					wait(tr.commit());
+					break;
+				} catch (Error& e) {
+					wait(tr.onError(e));
+				}
+			}
+			begin += 100;
+		}
+		return Void();
+	}
+
+	ACTOR static Future<Void> reader(Database cx, ReadHotspotBalanceWorkload* self, double delay) {
+		state double lastTime = now();
+		loop {
+			wait(poisson(&lastTime, delay));
+			state ReadYourWritesTransaction tr(cx);
+			loop {
+				try {
+					Optional<Value> v = wait(tr.get(self->keyForIndex(self->randomKeyIndex())));
+					++self->reads;
+					break;
+				} catch (Error& e) {
+					++self->errors;
+					wait(tr.onError(e));
+				}
+			}
+		}
+	}
+
+	// The busiest storage server's read bandwidth relative to the mean over the storage servers that responded, or 0
+	ACTOR static Future<double> getMaxToMeanReadRatio(Database cx) {
+		state vector<StorageServerInterface> storageServers = wait(getStorageServers(cx));
+		state std::vector<Future<ErrorOr<GetStorageMetricsReply>>> replies;
+		for (const auto& ssi : storageServers) {
+			replies.push_back(ssi.getStorageMetrics.tryGetReply(GetStorageMetricsRequest()));
+		}
+		wait(waitForAll(replies));
+
+		int64_t maxRead = 0;
+		int64_t totalRead = 0;
+		int responded = 0;
+		for (const auto& r : replies) {
+			if (r.get().present()) {
+				int64_t read = r.get().get().load.bytesReadPerKSecond;
+				maxRead = std::max(maxRead, read);
+				totalRead += read;
+				++responded;
+			}
+		}
+		return totalRead > 0 ? (double)maxRead * responded / totalRead : 0.0;
+	}
+
+	// Measured while the reads are running, since read bandwidth decays once they stop
+	ACTOR static Future<Void> monitor(Database cx, ReadHotspotBalanceWorkload* self) {
+		loop {
+			wait(delay(5.0));
+			double ratio = wait(getMaxToMeanReadRatio(cx));
+			self->peakMaxToMeanReadRatio = std::max(self->peakMaxToMeanReadRatio, ratio);
+			self->maxToMeanReadRatio = ratio;
+		}
+	}
+
+	// Data distribution can only move read load when there is another team to move it to, and only once the
+	// imbalance is past DD_READ_REBALANCE_DIFF_RATIO.  When both held at some point, the busiest server's share of the
+	// reads must have come down from its peak by the end of the run.
+	ACTOR static Future<bool> _check(Database cx, ReadHotspotBalanceWorkload* self) {
+		state DatabaseConfiguration config = wait(getDatabaseConfiguration(cx));
+		state vector<StorageServerInterface> storageServers = wait(getStorageServers(cx));
+		bool canBalance = g_network->isSimulated() && storageServers.size() > config.storageTeamSize &&
+		                  self->peakMaxToMeanReadRatio > SERVER_KNOBS->DD_READ_REBALANCE_DIFF_RATIO;
+		bool balanced = self->maxToMeanReadRatio < self->peakMaxToMeanReadRatio;
+
+		TraceEvent(canBalance && !balanced ? SevError : SevInfo, "ReadHotspotBalanceCheck")
+		    .detail("StorageServers", storageServers.size())
+		    .detail("TeamSize", config.storageTeamSize)
+		    .detail("PeakMaxToMeanReadRatio", self->peakMaxToMeanReadRatio)
+		    .detail("MaxToMeanReadRatio", self->maxToMeanReadRatio)
+		    .detail("Reads", self->reads.getValue())
+		    .detail("ReadRebalanceEnabled", SERVER_KNOBS->DD_READ_REBALANCE);
+
+		return self->reads.getValue() > 0 && (!canBalance || balanced);
+	}
+};
+
+WorkloadFactory<ReadHotspotBalanceWorkload> ReadHotspotBalanceWorkloadFactory("ReadHotspotBalance");
@@ -0,0 +1,122 @@
+/*
+ * StorageLocalThrottle.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2021 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/ReadYourWrites.h"
+#include "fdbserver/Knobs.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Turns on RATEKEEPER_STORAGE_LOCAL_THROTTLE and writes large values to a small range of keys, so that the storage
+// servers holding it fall behind while writes to the rest of the keyspace continue. Commit proxies should then reject
+// some writes to the hot range, but never all of them, and should leave writes to other shards alone.
+struct StorageLocalThrottleWorkload : TestWorkload {
+	double testDuration, hotTransactionsPerSecond, coldTransactionsPerSecond;
+	int hotKeyCount, coldKeyCount, hotValueBytes, coldValueBytes;
+	vector<Future<Void>> clients;
+	PerfIntCounter hotCommits, coldCommits, hotRejections, coldRejections;
+
+	StorageLocalThrottleWorkload(WorkloadContext const& wcx)
+	  : TestWorkload(wcx), hotCommits("HotCommits"), coldCommits("ColdCommits"), hotRejections("HotRejections"),
+	    coldRejections("ColdRejections") {
+		testDuration = getOption(options, LiteralStringRef("testDuration"), 60.0);
+		hotTransactionsPerSecond =
+		    getOption(options, LiteralStringRef("hotTransactionsPerSecond"), 1000.0) / clientCount;
+		coldTransactionsPerSecond =
+		    getOption(options, LiteralStringRef("coldTransactionsPerSecond"), 100.0) / clientCount;
+		hotKeyCount = getOption(options, LiteralStringRef("hotKeyCount"), 100);
+		coldKeyCount = getOption(options, LiteralStringRef("coldKeyCount"), 100000);
+		hotValueBytes = getOption(options, LiteralStringRef("hotValueBytes"), 10000);
+		coldValueBytes = getOption(options, LiteralStringRef("coldValueBytes"), 100);
+	}
+
+	std::string description() const override { return "StorageLocalThrottle"; }
+
+	Future<Void> setup(Database const& cx) override {
+		if (g_network->isSimulated()) {
+			ASSERT(const_cast<ServerKnobs*>(SERVER_KNOBS)->setKnob("ratekeeper_storage_local_throttle", "true"));
+		}
+		return Void();
+	}
+
+	Future<Void> start(Database const& cx) override {
+		int hotActors = std::max(1, (int)hotTransactionsPerSecond / 5);
+		int coldActors = std::max(1, (int)coldTransactionsPerSecond / 5);
+		for (int c = 0; c < hotActors; c++) {
+			clients.push_back(
+			    timeout(writer(cx->clone(), this, true, hotActors / hotTransactionsPerSecond), testDuration, Void()));
+		}
+		for (int c = 0; c < coldActors; c++) {
+			clients.push_back(
+			    timeout(writer(cx->clone(), this, false, coldActors / coldTransactionsPerSecond), testDuration, Void()));
+		}
+		return waitForAll(clients);
+	}
+
+	// Rejections cap below 1, so writes to the hot range keep committing however far behind its servers are
+	Future<bool> check(Database const& cx) override {
+		clients.clear();
+		TraceEvent("StorageLocalThrottleCheck")
+		    .detail("HotCommits", hotCommits.getValue())
+		    .detail("ColdCommits", coldCommits.getValue())
+		    .detail("HotRejections", hotRejections.getValue())
+		    .detail("ColdRejections", coldRejections.getValue());
+		return hotCommits.getValue() > 0 && coldCommits.getValue() > 0;
+	}
+
+	void getMetrics(vector<PerfMetric>& m) override {
+		m.push_back(hotCommits.getMetric());
+		m.push_back(coldCommits.getMetric());
+		m.push_back(hotRejections.getMetric());
+		m.push_back(coldRejections.getMetric());
+	}
+
+	Key keyFor(bool hot) const {
+		return hot ? StringRef(format("localthrottle/hot/%06d", deterministicRandom()->randomInt(0, hotKeyCount)))
+		           : StringRef(format("localthrottle/cold/%08x", deterministicRandom()->randomInt(0, coldKeyCount)));
+	}
+
+	ACTOR static Future<Void> writer(Database cx, StorageLocalThrottleWorkload* self, bool hot, double delay) {
+		state double lastTime = now();
+		state int valueBytes = hot ? self->hotValueBytes : self->coldValueBytes;
+		state Standalone<StringRef> value = makeString(valueBytes);
+		memset(mutateString(value), 'l', valueBytes);
+		loop {
+			wait(poisson(&lastTime, delay));
+			state ReadYourWritesTransaction tr(cx);
+			loop {
+				try {
+					tr.set(self->keyFor(hot), value);
+					wait(tr.commit());
+					++(hot ? self->hotCommits : self->coldCommits);
+					break;
+				} catch (Error& e) {
+					if (e.code() == error_code_proxy_memory_limit_exceeded) {
+						++(hot ? self->hotRejections : self->coldRejections);
+					}
+					wait(tr.onError(e));
+				}
+			}
+		}
+	}
+};
+
+WorkloadFactory<StorageLocalThrottleWorkload> StorageLocalThrottleWorkloadFactory("StorageLocalThrottle");
@@ -20,7 +20,10 @@
 
 #include <flow/Histogram.h>
 #include <flow/flow.h>
+#include <flow/ThreadHelper.actor.h>
 #include <flow/UnitTest.h>
+
+#include <array>
 // TODO: remove dependency on fdbrpc.
 
 // we need to be able to check if we're in simulation so that the histograms are properly
@@ -137,6 +140,49 @@ void Histogram::writeToLog() {
 
 #pragma endregion // Histogram
 
+#pragma region ThreadHistogramSampler
+
+static void addToHistogram(std::string const& group, std::string const& op, uint32_t const* counts) {
+	// Nothing is reporting a histogram that no longer exists, so its samples can be dropped
+	Histogram* h = GetHistogramRegistry().lookupHistogram(group + ":" + op);
+	if (h) {
+		for (int i = 0; i < 32; i++) {
+			h->buckets[i] += counts[i];
+		}
+	}
+}
+
+ThreadHistogramSampler::ThreadHistogramSampler(std::string group, std::string op)
+  : group(group), op(op), empty(true), lastFlush(timer_monotonic()) {
+	std::fill(std::begin(buckets), std::end(buckets), 0);
+}
+
+void ThreadHistogramSampler::sample(uint32_t sample) {
+	buckets[Histogram::bucketFor(sample)]++;
+	empty = false;
+	if (timer_monotonic() - lastFlush >= FLOW_KNOBS->HISTOGRAM_THREAD_FLUSH_INTERVAL) {
+		flush();
+	}
+}
+
+void ThreadHistogramSampler::flush() {
+	lastFlush = timer_monotonic();
+	if (empty) {
+		return;
+	}
+	if (g_network->isOnMainThread()) {
+		addToHistogram(group, op, buckets);
+	} else {
+		std::array<uint32_t, 32> counts;
+		std::copy(std::begin(buckets), std::end(buckets), counts.begin());
+		onMainThreadVoid([group = group, op = op, counts]() { addToHistogram(group, op, counts.data()); }, nullptr);
+	}
+	std::fill(std::begin(buckets), std::end(buckets), 0);
+	empty = true;
+}
+
+#pragma endregion // ThreadHistogramSampler
+
 TEST_CASE("/flow/histogram/smoke_test") {
 
 	{
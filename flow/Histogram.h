@@ -92,7 +92,10 @@ public:
 	}
 
 	// This histogram buckets samples into powers of two.
-	inline void sample(uint32_t sample) {
+	inline void sample(uint32_t sample) { buckets[bucketFor(sample)]++; }
+
+	// Index of the bucket that sample() counts the given value in
+	static inline size_t bucketFor(uint32_t sample) {
 		size_t idx;
 #ifdef _WIN32
 		unsigned long index;
@@ -106,15 +109,17 @@ public:
 		idx = sample ? (31 - __builtin_clz(sample)) : 0;
 #endif
 		ASSERT(idx < 32);
-		buckets[idx]++;
+		return idx;
 	}
 
-	inline void sampleSeconds(double delta) {
+	inline void sampleSeconds(double delta) { sample(toMicroseconds(delta)); }
+
+	static inline uint32_t toMicroseconds(double delta) {
 		uint64_t delta_usec = (delta * 1000000);
 		if (delta_usec > UINT32_MAX) {
-			sample(UINT32_MAX);
+			return UINT32_MAX;
 		} else {
-			sample((uint32_t)(delta * 1000000)); // convert to microseconds and truncate to integer
+			return (uint32_t)(delta * 1000000); // convert to microseconds and truncate to integer
 		}
 	}
 
@@ -134,4 +139,29 @@ public:
 	uint32_t buckets[32];
 };
 
+/*
+ * Histograms are read and cleared by HistogramRegistry::logReport() on the network thread without any locking, so
+ * threads other than the network thread must not sample into them directly.  Such a thread keeps its own
+ * ThreadHistogramSampler instead, and every FLOW_KNOBS->HISTOGRAM_THREAD_FLUSH_INTERVAL seconds the counts gathered so
+ * far are handed to the network thread, which adds them to the Histogram with the same group and op.
+ */
+class ThreadHistogramSampler {
+public:
+	ThreadHistogramSampler(std::string group, std::string op);
+
+	void sample(uint32_t sample);
+	void sampleSeconds(double delta) { sample(Histogram::toMicroseconds(delta)); }
+
+	// Hands over everything sampled so far.  Call it from the sampling thread, or from the network thread once the
+	// sampling thread has stopped.
+	void flush();
+
+private:
+	std::string const group;
+	std::string const op;
+	uint32_t buckets[32];
+	bool empty;
+	double lastFlush;
+};
+
 #endif // FLOW_HISTOGRAM_H
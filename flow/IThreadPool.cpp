@@ -19,8 +19,13 @@
  */
 
 #include "flow/IThreadPool.h"
+#include "flow/Histogram.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #define BOOST_SYSTEM_NO_LIB
 #define BOOST_DATE_TIME_NO_LIB
 #define BOOST_REGEX_NO_LIB
@@ -119,3 +124,209 @@ Reference<IThreadPool> createGenericThreadPool(int stackSize) {
 }
 
 thread_local IThreadPoolReceiver* ThreadPool::Thread::threadUserObject;
+
+class WorkStealingThreadPool final : public IThreadPool, public ReferenceCounted<WorkStealingThreadPool> {
+	struct QueuedAction {
+		PThreadAction action;
+		double queuedTime;
+	};
+
+	struct Worker {
+		WorkStealingThreadPool* pool;
+		IThreadPoolReceiver* userObject;
+		THREAD_HANDLE handle; // Owned by main thread
+		int index;
+		int cpu;
+		ThreadSpinLock lock; // Protects lanes
+		std::deque<QueuedAction> lanes[THREAD_ACTION_LANE_COUNT];
+		std::vector<ThreadHistogramSampler> queueWait; // Per lane; only used on this worker's thread until it exits
+
+		Worker(WorkStealingThreadPool* pool, IThreadPoolReceiver* userObject, int index, int cpu)
+		  : pool(pool), userObject(userObject), index(index), cpu(cpu) {
+			for (int lane = 0; lane < THREAD_ACTION_LANE_COUNT; ++lane) {
+				queueWait.emplace_back(pool->name, laneHistogramNames[lane]);
+			}
+		}
+		~Worker() { ASSERT_ABORT(!userObject); }
+
+		void run() {
+			deprioritizeThread();
+			if (cpu >= 0) {
+				setAffinity(cpu);
+			}
+
+			currentWorker = this;
+			try {
+				userObject->init();
+				loop {
+					// Every post() adds one to queued, so a successful take() means some worker's lanes hold at
+					// least one action that no other thread will claim.
+					pool->queued.take();
+					if (pool->mode == Mode::Shutdown) {
+						break;
+					}
+					PThreadAction action = pool->take(this);
+					(*action)(userObject);
+				}
+			} catch (Error& e) {
+				TraceEvent(SevError, "ThreadPoolError").error(e);
+			}
+			currentWorker = nullptr;
+			delete userObject;
+			userObject = nullptr;
+		}
+
+		bool tryPop(int lane, bool fromBack, QueuedAction& out) {
+			ThreadSpinLockHolder holder(lock);
+			auto& q = lanes[lane];
+			if (q.empty()) {
+				return false;
+			}
+			if (fromBack) {
+				out = q.back();
+				q.pop_back();
+			} else {
+				out = q.front();
+				q.pop_front();
+			}
+			return true;
+		}
+	};
+	THREAD_FUNC start(void* p) {
+		((Worker*)p)->run();
+		THREAD_RETURN;
+	}
+
+	// Counts queued actions that no worker has claimed yet.  Event can't be used for this: on Windows it is a binary
+	// auto-reset event, so several set() calls before a wakeup would be collapsed into one.
+	struct ActionCount {
+		std::mutex mutex;
+		std::condition_variable nonZero;
+		int64_t count = 0;
+
+		void add() {
+			{
+				std::lock_guard<std::mutex> holder(mutex);
+				++count;
+			}
+			nonZero.notify_one();
+		}
+		void take() {
+			std::unique_lock<std::mutex> holder(mutex);
+			nonZero.wait(holder, [this] { return count > 0; });
+			--count;
+		}
+	};
+
+	static thread_local Worker* currentWorker;
+	static const char* const laneHistogramNames[THREAD_ACTION_LANE_COUNT];
+
+	std::string name;
+	int stackSize;
+	std::vector<int> cpus;
+	std::vector<Worker*> workers;
+	std::atomic<unsigned> nextWorker;
+	bool posted;
+	ActionCount queued;
+	enum Mode { Run = 0, Shutdown = 2 };
+	volatile int mode;
+	// Workers sample into their own ThreadHistogramSamplers; these only keep the shared histograms registered
+	Reference<Histogram> queueWaitHistograms[THREAD_ACTION_LANE_COUNT];
+
+	// Workers drain their own queue oldest first and steal newest first, lane by lane, so a High lane action
+	// never waits behind a Low lane one while any worker is free.
+	PThreadAction take(Worker* self) {
+		QueuedAction next;
+		int n = workers.size();
+		for (int lane = 0; lane < THREAD_ACTION_LANE_COUNT; ++lane) {
+			for (int i = 0; i < n; ++i) {
+				Worker* victim = workers[(self->index + i) % n];
+				if (victim->tryPop(lane, victim != self, next)) {
+					self->queueWait[lane].sampleSeconds(timer_monotonic() - next.queuedTime);
+					return next.action;
+				}
+			}
+		}
+		UNSTOPPABLE_ASSERT(false);
+		return nullptr;
+	}
+
+public:
+	WorkStealingThreadPool(std::string const& name, int stackSize, std::vector<int> const& cpus)
+	  : name(name), stackSize(stackSize), cpus(cpus), nextWorker(0), posted(false), mode(Run) {
+		for (int lane = 0; lane < THREAD_ACTION_LANE_COUNT; ++lane) {
+			queueWaitHistograms[lane] = Histogram::getHistogram(
+			    StringRef(name), StringRef(laneHistogramNames[lane]), Histogram::Unit::microseconds);
+		}
+	}
+	~WorkStealingThreadPool() override {}
+
+	Future<Void> stop(Error const& e = success()) override {
+		if (mode == Shutdown)
+			return Void();
+		ReferenceCounted<WorkStealingThreadPool>::addref();
+		mode = Shutdown;
+		for (int i = 0; i < workers.size(); i++) {
+			queued.add();
+		}
+		for (auto w : workers) {
+			waitThread(w->handle);
+		}
+		for (auto w : workers) {
+			for (auto& sampler : w->queueWait) {
+				sampler.flush();
+			}
+			for (auto& lane : w->lanes) {
+				for (auto& a : lane) {
+					a.action->cancel();
+				}
+			}
+			delete w;
+		}
+		workers.clear();
+		ReferenceCounted<WorkStealingThreadPool>::delref();
+		return Void();
+	}
+
+	Future<Void> getError() const override { return Never(); } // FIXME
+	void addref() override { ReferenceCounted<WorkStealingThreadPool>::addref(); }
+	void delref() override {
+		if (ReferenceCounted<WorkStealingThreadPool>::delref_no_destroy()) {
+			stop();
+			delete this;
+		}
+	}
+	void addThread(IThreadPoolReceiver* userData, const char* threadName) override {
+		// Running workers read the worker list without locking, so it must be complete before any work arrives
+		ASSERT(!posted);
+		int cpu = cpus.empty() ? -1 : cpus[workers.size() % cpus.size()];
+		workers.push_back(new Worker(this, userData, workers.size(), cpu));
+		workers.back()->handle = startThread(start, workers.back(), stackSize, threadName);
+	}
+	void post(PThreadAction action) override {
+		if (mode == Shutdown) {
+			action->cancel();
+			return;
+		}
+		ASSERT(!workers.empty());
+		posted = true;
+		// Work posted from one of our own threads stays local; everything else is spread round robin
+		Worker* w = currentWorker && currentWorker->pool == this ? currentWorker
+		                                                         : workers[nextWorker++ % workers.size()];
+		{
+			ThreadSpinLockHolder holder(w->lock);
+			w->lanes[static_cast<int>(action->getLane())].push_back(QueuedAction{ action, timer_monotonic() });
+		}
+		queued.add();
+	}
+};
+
+thread_local WorkStealingThreadPool::Worker* WorkStealingThreadPool::currentWorker;
+const char* const WorkStealingThreadPool::laneHistogramNames[THREAD_ACTION_LANE_COUNT] = { "HighLaneQueueWait",
+	                                                                                        "LowLaneQueueWait" };
+
+Reference<IThreadPool> createWorkStealingThreadPool(std::string const& name,
+                                                    int stackSize,
+                                                    std::vector<int> const& cpus) {
+	return Reference<IThreadPool>(new WorkStealingThreadPool(name, stackSize, cpus));
+}
@@ -41,6 +41,9 @@
 
 // TypedAction<> is a utility subclass to make it easier to create thread actions and receivers.
 
+// Pools created with createWorkStealingThreadPool() keep a queue per thread, let idle threads steal queued
+// actions from busy ones, and always run queued actions in the High lane before those in the Low lane.
+
 // ThreadReturnPromise<> can be safely use to pass return values from thread actions back to the g_network thread
 
 class IThreadPoolReceiver {
@@ -49,10 +52,15 @@ public:
 	virtual void init() = 0;
 };
 
+enum class ThreadActionLane { High = 0, Low = 1 };
+constexpr int THREAD_ACTION_LANE_COUNT = 2;
+
 struct ThreadAction {
 	virtual void operator()(IThreadPoolReceiver*) = 0; // self-destructs
 	virtual void cancel() = 0;
 	virtual double getTimeEstimate() const = 0; // for simulation
+	// Long running actions (e.g. range reads) should use the Low lane so they don't delay short ones
+	virtual ThreadActionLane getLane() const { return ThreadActionLane::High; }
 };
 typedef ThreadAction* PThreadAction;
 
@@ -113,6 +121,12 @@ private:
 
 Reference<IThreadPool> createGenericThreadPool(int stackSize = 0);
 
+// Queue wait times are recorded per lane in the histograms "<name>:HighLaneQueueWait" and "<name>:LowLaneQueueWait".
+// If cpus is non-empty, the i-th thread added is pinned to cpus[i % cpus.size()].
+Reference<IThreadPool> createWorkStealingThreadPool(std::string const& name,
+                                                    int stackSize = 0,
+                                                    std::vector<int> const& cpus = std::vector<int>());
+
 class DummyThreadPool final : public IThreadPool, ReferenceCounted<DummyThreadPool> {
 public:
 	~DummyThreadPool() override {}
@@ -89,6 +89,11 @@ void FlowKnobs::initialize(bool randomize, bool isSimulated) {
 	init( PING_LOGGING_INTERVAL,                               3.0 );
 	init( PING_SAMPLE_AMOUNT,                                  100 );
 	init( NETWORK_CONNECT_SAMPLE_AMOUNT,                       100 );
+	init( ENDPOINT_LATENCY_HISTOGRAMS,                       false ); if( randomize && BUGGIFY ) ENDPOINT_LATENCY_HISTOGRAMS = true;
+	init( ENDPOINT_LATENCY_LOGGING_INTERVAL,                   5.0 );
+	init( ENDPOINT_LATENCY_SAMPLE_AMOUNT,                      100 );
+	init( ENDPOINT_LATENCY_LOGGED_TYPES,                         8 ); // Keeps EndpointLatencyMetrics under MAX_TRACE_EVENT_LENGTH
+	init( HISTOGRAM_THREAD_FLUSH_INTERVAL,                     1.0 ); if( randomize && BUGGIFY ) HISTOGRAM_THREAD_FLUSH_INTERVAL = 0.0;
 
 	init( TLS_CERT_REFRESH_DELAY_SECONDS,                 12*60*60 );
 	init( TLS_SERVER_CONNECTION_THROTTLE_TIMEOUT,              9.0 );
@@ -115,7 +120,10 @@ void FlowKnobs::initialize(bool randomize, bool isSimulated) {
 	init( BUGGIFY_SIM_PAGE_CACHE_4K,                           1e6 );
 	init( BUGGIFY_SIM_PAGE_CACHE_64K,                          1e6 );
 	init( MAX_EVICT_ATTEMPTS,                                  100 ); if( randomize && BUGGIFY ) MAX_EVICT_ATTEMPTS = 2;
-	init( CACHE_EVICTION_POLICY,                          "random" );
+	init( CACHE_EVICTION_POLICY,                          "random" ); if( randomize && BUGGIFY ) CACHE_EVICTION_POLICY = "2q";
+	init( PAGE_CACHE_2Q_PROBATION_FRACTION,                   0.25 ); if( randomize && BUGGIFY ) PAGE_CACHE_2Q_PROBATION_FRACTION = deterministicRandom()->random01();
+	init( PAGE_CACHE_PREFETCH_TRIGGER,                           4 ); if( randomize && BUGGIFY ) PAGE_CACHE_PREFETCH_TRIGGER = 1;
+	init( PAGE_CACHE_PREFETCH_PAGES,                             0 ); if( randomize && BUGGIFY ) PAGE_CACHE_PREFETCH_PAGES = deterministicRandom()->randomInt(1, 33);
 	init( PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION,                 0.1 ); if( randomize && BUGGIFY ) PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION = 0.0; else if( randomize && BUGGIFY ) PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION = 1.0;
 	init( FLOW_CACHEDFILE_WRITE_IO_SIZE,                         0 );
 	if ( randomize && BUGGIFY) {
@@ -156,6 +164,7 @@ void FlowKnobs::initialize(bool randomize, bool isSimulated) {
 	init( MIN_LOGGED_PRIORITY_BUSY_FRACTION,                  0.05 );
 	init( CERT_FILE_MAX_SIZE,                      5 * 1024 * 1024 );
 	init( READY_QUEUE_RESERVED_SIZE,                          8192 );
+	init( NETWORK_THREAD_CPU_AFFINITY,                          -1 ); // -1 leaves the run loop thread unpinned
 
 	//Network
 	init( PACKET_LIMIT,                                  100LL<<20 );
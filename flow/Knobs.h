@@ -104,6 +104,11 @@ public:
 	double PING_LOGGING_INTERVAL;
 	int PING_SAMPLE_AMOUNT;
 	int NETWORK_CONNECT_SAMPLE_AMOUNT;
+	bool ENDPOINT_LATENCY_HISTOGRAMS;
+	double ENDPOINT_LATENCY_LOGGING_INTERVAL;
+	int ENDPOINT_LATENCY_SAMPLE_AMOUNT;
+	int ENDPOINT_LATENCY_LOGGED_TYPES;
+	double HISTOGRAM_THREAD_FLUSH_INTERVAL;
 
 	int TLS_CERT_REFRESH_DELAY_SECONDS;
 	double TLS_SERVER_CONNECTION_THROTTLE_TIMEOUT;
@@ -129,7 +134,10 @@ public:
 	int64_t SIM_PAGE_CACHE_64K;
 	int64_t BUGGIFY_SIM_PAGE_CACHE_4K;
 	int64_t BUGGIFY_SIM_PAGE_CACHE_64K;
-	std::string CACHE_EVICTION_POLICY; // for now, "random", "lru", are supported
+	std::string CACHE_EVICTION_POLICY; // "random", "lru" and "2q" are supported
+	double PAGE_CACHE_2Q_PROBATION_FRACTION; // Share of the cache that 2Q evicts single-use pages from first
+	int PAGE_CACHE_PREFETCH_TRIGGER; // Sequential page reads before readahead starts
+	int PAGE_CACHE_PREFETCH_PAGES; // Pages kept loading ahead of a sequential reader; 0 disables
 	int MAX_EVICT_ATTEMPTS;
 	double PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION;
 	double TOO_MANY_CONNECTIONS_CLOSED_RESET_DELAY;
@@ -171,6 +179,7 @@ public:
 	double MIN_LOGGED_PRIORITY_BUSY_FRACTION;
 	int CERT_FILE_MAX_SIZE;
 	int READY_QUEUE_RESERVED_SIZE;
+	int NETWORK_THREAD_CPU_AFFINITY;
 
 	// Network
 	int64_t PACKET_LIMIT;
@@ -1389,6 +1389,12 @@ void Net2::run() {
 
 	thread_network = this;
 
+	if (FLOW_KNOBS->NETWORK_THREAD_CPU_AFFINITY >= 0) {
+		// Pinning the run loop lets several single-threaded processes share a host without migrating between cores
+		setAffinity(FLOW_KNOBS->NETWORK_THREAD_CPU_AFFINITY);
+		TraceEvent("Net2RunLoopPinned").detail("CPU", FLOW_KNOBS->NETWORK_THREAD_CPU_AFFINITY);
+	}
+
 #ifdef WIN32
 	if (timeBeginPeriod(1) != TIMERR_NOERROR)
 		TraceEvent(SevError, "TimeBeginPeriodError");
@@ -124,6 +124,15 @@ public:
 
 	Arena& arena() { return _arena; }
 
+	// Deserializes a T whose Ref members are copied into T's own arena, so the result does not depend on input
+	template <class T, class VersionOptions>
+	static T fromStringRef(StringRef input, VersionOptions vo) {
+		T t;
+		ObjectReader reader(input.begin(), vo);
+		reader.deserialize(t);
+		return t;
+	}
+
 private:
 	const uint8_t* _data;
 	Arena _arena;
@@ -152,6 +161,17 @@ public:
 
 	Arena& arena() { return _arena; }
 
+	// Deserializes a T as a read-only view over input: StringRefs (including the elements of String-serialized
+	// VectorRefs such as GetKeyValuesReply::data) point directly into input's bytes, and any Arena member of T takes a
+	// reference to input's arena instead of receiving a copy.
+	template <class T, class VersionOptions>
+	static T fromStringRef(Standalone<StringRef> input, VersionOptions vo) {
+		T t;
+		ArenaObjectReader reader(input.arena(), input, vo);
+		reader.deserialize(t);
+		return t;
+	}
+
 private:
 	const uint8_t* _data;
 	Arena _arena;
@@ -37,6 +37,8 @@ The views and conclusions contained in the software and documentation are those
 interpreted as representing official policies, either expressed or implied, of Dmitry Vyukov.*/
 
 #include <atomic>
+#include <cstdint>
+#include <memory>
 
 #if VALGRIND
 #include <drd.h>
@@ -52,6 +54,7 @@ class ThreadSafeQueue : NonCopyable {
 	struct Node : BaseNode, FastAllocated<Node> {
 		T data;
 		Node(T const& data) : data(data) {}
+		Node(T&& data) : data(std::move(data)) {}
 	};
 	std::atomic<BaseNode*> head;
 	BaseNode* tail;
@@ -131,11 +134,8 @@ public:
 	}
 
 	// If push() returns true, the consumer may be sleeping and should be woken
-	bool push(T const& data) {
-		Node* n = new Node(data);
-		n->data = data;
-		return pushNode(n) == &sleeping;
-	}
+	bool push(T const& data) { return pushNode(new Node(data)) == &sleeping; }
+	bool push(T&& data) { return pushNode(new Node(std::move(data))) == &sleeping; }
 
 	///////////// The below functions may only be called by a single, consumer thread //////////////////
 
@@ -182,3 +182,97 @@ public:
 		return Optional<T>(std::move(data));
 	}
 };
+
+// BoundedThreadSafeQueue<T, Capacity> is a fixed capacity multi-producer, single-consumer ring buffer with the same
+// canSleep()/push() wakeup protocol as ThreadSafeQueue.  Unlike ThreadSafeQueue it never allocates after
+// construction and producers do not all contend on a single head pointer, which makes it the better choice for
+// high rate completion paths.  tryPush() fails instead of blocking when the ring is full, so a producer must have
+// somewhere else to put the item (typically an unbounded ThreadSafeQueue).
+//
+// Based on the bounded MPMC queue at
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue, covered by the license above.
+template <class T, size_t Capacity>
+class BoundedThreadSafeQueue : NonCopyable {
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	struct Cell {
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	// Each cell's sequence is equal to its position when it is free for the producer that claims that position, and
+	// to position + 1 once the data is published.  The consumer sets it to position + Capacity when it is drained.
+	std::unique_ptr<Cell[]> cells;
+	alignas(64) std::atomic<size_t> enqueuePos;
+	alignas(64) size_t dequeuePos; // Only touched by the consumer
+	std::atomic<bool> sleeping;
+
+	bool ready(size_t pos) const {
+		return cells[pos & (Capacity - 1)].sequence.load() == pos + 1;
+	}
+
+public:
+	BoundedThreadSafeQueue() : cells(new Cell[Capacity]), enqueuePos(0), dequeuePos(0), sleeping(false) {
+		for (size_t i = 0; i < Capacity; i++) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// Returns false, leaving data untouched, if the queue is full.  Otherwise sets wake to true if the consumer may be
+	// sleeping and should be woken.  At most one push() per canSleep() reports that a wakeup is needed, so producers
+	// completing a burst of work cost the consumer a single wakeup.
+	template <class U>
+	bool tryPush(U&& data, bool& wake) {
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;) {
+			cell = &cells[pos & (Capacity - 1)];
+			size_t seq = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->data = std::forward<U>(data);
+		// Sequentially consistent store and exchange pair with those in canSleep(): either the consumer sees this item
+		// or this producer sees the consumer going to sleep.
+		cell->sequence.store(pos + 1);
+		wake = sleeping.load() && sleeping.exchange(false);
+		return true;
+	}
+
+	size_t capacity() const { return Capacity; }
+
+	///////////// The below functions may only be called by a single, consumer thread //////////////////
+
+	// If canSleep returns true, then the queue is empty and the next successful tryPush() will set wake
+	bool canSleep() {
+		if (ready(dequeuePos)) {
+			return false;
+		}
+		sleeping.store(true);
+		if (ready(dequeuePos)) {
+			sleeping.store(false);
+			return false;
+		}
+		return true;
+	}
+
+	Optional<T> pop() {
+		Cell& cell = cells[dequeuePos & (Capacity - 1)];
+		if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+			return Optional<T>();
+		}
+		Optional<T> data(std::move(cell.data));
+		cell.data = T();
+		cell.sequence.store(dequeuePos + Capacity, std::memory_order_release);
+		++dequeuePos;
+		return data;
+	}
+};
@@ -498,6 +498,29 @@ TEST_CASE("/flow/FlatBuffers/Standalone") {
 	return Void();
 }
 
+TEST_CASE("/flow/FlatBuffers/ZeroCopyView") {
+	Standalone<VectorRef<StringRef>> vecIn;
+	auto numElements = deterministicRandom()->randomInt(1, 20);
+	for (int i = 0; i < numElements; ++i) {
+		auto str = deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(1, 30));
+		vecIn.push_back_deep(vecIn.arena(), StringRef(str));
+	}
+	Standalone<StringRef> value = ObjectWriter::toValue(vecIn, Unversioned());
+
+	// The view's strings must point into the serialized bytes, while the copying reader must not
+	Standalone<VectorRef<StringRef>> view =
+	    ArenaObjectReader::fromStringRef<Standalone<VectorRef<StringRef>>>(value, Unversioned());
+	Standalone<VectorRef<StringRef>> copy =
+	    ObjectReader::fromStringRef<Standalone<VectorRef<StringRef>>>(value, Unversioned());
+	ASSERT(view.size() == vecIn.size() && copy.size() == vecIn.size());
+	for (int i = 0; i < vecIn.size(); ++i) {
+		ASSERT(view[i] == vecIn[i] && copy[i] == vecIn[i]);
+		ASSERT(view[i].begin() >= value.begin() && view[i].end() <= value.end());
+		ASSERT(copy[i].begin() < value.begin() || copy[i].begin() >= value.end());
+	}
+	return Void();
+}
+
 // Meant to be run with valgrind or asan, to catch heap buffer overflows
 TEST_CASE("/flow/FlatBuffers/Void") {
 	Standalone<StringRef> msg = ObjectWriter::toValue(Void(), Unversioned());
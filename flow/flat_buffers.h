@@ -1050,12 +1050,22 @@ struct LoadSaveHelper : Context {
 		current += sizeof(uint32_t);
 		VectorTraits::reserve(member, numEntries, this->context());
 		auto inserter = VectorTraits::insert(member, this->context());
-		for (uint32_t i = 0; i < numEntries; ++i) {
-			T value;
-			load_helper(value, current, this->context());
-			*inserter = std::move(value);
-			++inserter;
-			current += fb_size<T>;
+		if constexpr (std::is_pointer_v<typename VectorTraits::insert_iterator>) {
+			// reserve() already constructed the elements in place (e.g. in a VectorRef's arena), so load straight
+			// into them instead of going through a temporary
+			for (uint32_t i = 0; i < numEntries; ++i) {
+				load_helper(*inserter, current, this->context());
+				++inserter;
+				current += fb_size<T>;
+			}
+		} else {
+			for (uint32_t i = 0; i < numEntries; ++i) {
+				T value;
+				load_helper(value, current, this->context());
+				*inserter = std::move(value);
+				++inserter;
+				current += fb_size<T>;
+			}
 		}
 	}
 
@@ -0,0 +1,128 @@
+/*
+ * BenchQueue.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2021 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "flow/Arena.h"
+#include "flow/ThreadSafeQueue.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Models the path taken by results handed back to the network thread: state.range(0) producer threads each complete
+// a fixed number of items while a single consumer drains the queue, sleeping on a condition variable (standing in for
+// the reactor's eventfd) whenever canSleep() allows it.  The wakeups counter reports how many of those completions had
+// to pay for a wakeup.
+
+static constexpr int itemsPerProducer = 100000;
+
+struct Waker {
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool signalled = false;
+	long wakeups = 0;
+
+	void wake() {
+		std::lock_guard<std::mutex> lock(mutex);
+		signalled = true;
+		++wakeups;
+		cv.notify_one();
+	}
+	void sleep() {
+		std::unique_lock<std::mutex> lock(mutex);
+		cv.wait(lock, [this] { return signalled; });
+		signalled = false;
+	}
+};
+
+struct UnboundedQueue {
+	ThreadSafeQueue<int> queue;
+
+	bool push(int i) { return queue.push(i); }
+	Optional<int> pop() { return queue.pop(); }
+	bool canSleep() { return queue.canSleep(); }
+};
+
+struct BoundedQueue {
+	BoundedThreadSafeQueue<int, 4096> queue;
+
+	bool push(int i) {
+		bool wake = false;
+		while (!queue.tryPush(i, wake)) {
+			std::this_thread::yield();
+		}
+		return wake;
+	}
+	Optional<int> pop() { return queue.pop(); }
+	bool canSleep() { return queue.canSleep(); }
+};
+
+template <class Queue>
+static void bench_cross_thread_completions(benchmark::State& state) {
+	const int producers = state.range(0);
+	const long total = (long)producers * itemsPerProducer;
+	long wakeups = 0;
+	while (state.KeepRunning()) {
+		Queue q;
+		Waker waker;
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producers; ++p) {
+			threads.emplace_back([&q, &waker] {
+				for (int i = 0; i < itemsPerProducer; ++i) {
+					if (q.push(i)) {
+						waker.wake();
+					}
+				}
+			});
+		}
+		long received = 0;
+		while (received < total) {
+			while (q.pop().present()) {
+				++received;
+			}
+			if (received < total && q.canSleep()) {
+				waker.sleep();
+			}
+		}
+		for (auto& t : threads) {
+			t.join();
+		}
+		wakeups += waker.wakeups;
+	}
+	state.SetItemsProcessed(total * static_cast<long>(state.iterations()));
+	state.counters["wakeups"] = benchmark::Counter(wakeups, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_TEMPLATE(bench_cross_thread_completions, UnboundedQueue)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_cross_thread_completions, BoundedQueue)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->ReportAggregatesOnly(true);
@@ -0,0 +1,161 @@
+/*
+ * BenchSerialize.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2021 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/CommitTransaction.h"
+#include "fdbclient/FDBTypes.h"
+#include "fdbclient/StorageServerInterface.h"
+#include "flow/Arena.h"
+#include "flow/ObjectSerializer.h"
+#include "flowbench/GlobalData.h"
+
+enum class ReadMode {
+	// ObjectReader: every StringRef is copied into the reader's arena
+	Copy,
+	// ArenaObjectReader: the result is a view over the serialized bytes
+	View,
+};
+
+static constexpr FileIdentifier mutationBatchFileIdentifier = 5583240;
+
+static GetKeyValuesReply makeGetKeyValuesReply(int rows, size_t valueSize) {
+	GetKeyValuesReply reply;
+	auto kv = getKV(16, valueSize);
+	reply.data.reserve(reply.arena, rows);
+	for (int i = 0; i < rows; ++i) {
+		reply.data.push_back(reply.arena, kv);
+	}
+	reply.version = 1;
+	reply.more = true;
+	return reply;
+}
+
+static Standalone<VectorRef<MutationRef>> makeMutationBatch(int mutations, size_t valueSize) {
+	Standalone<VectorRef<MutationRef>> batch;
+	auto kv = getKV(16, valueSize);
+	batch.reserve(batch.arena(), mutations);
+	for (int i = 0; i < mutations; ++i) {
+		batch.emplace_back(batch.arena(), MutationRef::Type::SetValue, kv.key, kv.value);
+	}
+	return batch;
+}
+
+template <class T>
+static void deserializeValue(ReadMode mode, Standalone<StringRef> const& value, T& out) {
+	if (mode == ReadMode::View) {
+		ArenaObjectReader reader(value.arena(), value, Unversioned());
+		reader.deserialize(out);
+	} else {
+		ObjectReader reader(value.begin(), Unversioned());
+		reader.deserialize(out);
+	}
+}
+
+static void bench_serialize_get_key_values_reply(benchmark::State& state) {
+	auto reply = makeGetKeyValuesReply(state.range(0), state.range(1));
+	size_t bytes = 0;
+	while (state.KeepRunning()) {
+		Standalone<StringRef> value = ObjectWriter::toValue(reply, Unversioned());
+		bytes += value.size();
+		benchmark::DoNotOptimize(value);
+	}
+	state.SetItemsProcessed(state.range(0) * static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(bytes);
+}
+
+template <ReadMode mode>
+static void bench_deserialize_get_key_values_reply(benchmark::State& state) {
+	Standalone<StringRef> value =
+	    ObjectWriter::toValue(makeGetKeyValuesReply(state.range(0), state.range(1)), Unversioned());
+	while (state.KeepRunning()) {
+		GetKeyValuesReply reply;
+		deserializeValue(mode, value, reply);
+		benchmark::DoNotOptimize(reply);
+	}
+	state.SetItemsProcessed(state.range(0) * static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(value.size() * static_cast<long>(state.iterations()));
+}
+
+template <ReadMode mode>
+static void bench_deserialize_get_value_reply(benchmark::State& state) {
+	auto kv = getKV(16, state.range(0));
+	Standalone<StringRef> value =
+	    ObjectWriter::toValue(GetValueReply(Optional<Value>(Value(kv.value)), false), Unversioned());
+	while (state.KeepRunning()) {
+		GetValueReply reply;
+		deserializeValue(mode, value, reply);
+		benchmark::DoNotOptimize(reply);
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(value.size() * static_cast<long>(state.iterations()));
+}
+
+static void bench_serialize_mutations(benchmark::State& state) {
+	auto batch = makeMutationBatch(state.range(0), state.range(1));
+	size_t bytes = 0;
+	while (state.KeepRunning()) {
+		ObjectWriter writer(Unversioned());
+		writer.serialize(mutationBatchFileIdentifier, batch);
+		bytes += writer.toStringRef().size();
+		benchmark::DoNotOptimize(writer);
+	}
+	state.SetItemsProcessed(state.range(0) * static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(bytes);
+}
+
+template <ReadMode mode>
+static void bench_deserialize_mutations(benchmark::State& state) {
+	ObjectWriter writer(Unversioned());
+	writer.serialize(mutationBatchFileIdentifier, makeMutationBatch(state.range(0), state.range(1)));
+	Standalone<StringRef> value = writer.toString();
+	while (state.KeepRunning()) {
+		Standalone<VectorRef<MutationRef>> batch;
+		if constexpr (mode == ReadMode::View) {
+			ArenaObjectReader reader(value.arena(), value, Unversioned());
+			reader.deserialize(mutationBatchFileIdentifier, batch);
+		} else {
+			ObjectReader reader(value.begin(), Unversioned());
+			reader.deserialize(mutationBatchFileIdentifier, batch);
+		}
+		benchmark::DoNotOptimize(batch);
+	}
+	state.SetItemsProcessed(state.range(0) * static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(value.size() * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_serialize_get_key_values_reply)->Ranges({ { 1, 1000 }, { 16, 1000 } })->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_deserialize_get_key_values_reply, ReadMode::Copy)
+    ->Ranges({ { 1, 1000 }, { 16, 1000 } })
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_deserialize_get_key_values_reply, ReadMode::View)
+    ->Ranges({ { 1, 1000 }, { 16, 1000 } })
+    ->ReportAggregatesOnly(true);
+
+BENCHMARK_TEMPLATE(bench_deserialize_get_value_reply, ReadMode::Copy)->Range(16, 1 << 16)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_deserialize_get_value_reply, ReadMode::View)->Range(16, 1 << 16)->ReportAggregatesOnly(true);
+
+BENCHMARK(bench_serialize_mutations)->Ranges({ { 1, 1000 }, { 16, 1000 } })->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_deserialize_mutations, ReadMode::Copy)
+    ->Ranges({ { 1, 1000 }, { 16, 1000 } })
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_deserialize_mutations, ReadMode::View)
+    ->Ranges({ { 1, 1000 }, { 16, 1000 } })
+    ->ReportAggregatesOnly(true);